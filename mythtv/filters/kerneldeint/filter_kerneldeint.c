@@ -11,7 +11,6 @@
 
 #include <string.h>
 #include <math.h>
-#include <pthread.h>
 
 #include "filter.h"
 #include "mythframe.h"
@@ -19,6 +18,7 @@
 #include "mythlogging.h"
 
 #include "../mm_arch.h"
+#include "../slicethreads.h"
 
 #undef ABS
 #define ABS(A) ( (A) > 0 ? (A) : -(A) )
@@ -36,25 +36,13 @@ static const mmx_t mm_cpool[] = { { 0x0000000000000000LL }, };
 #define mmx_t int
 #endif
 
-struct DeintThread
-{
-    int       ready;
-    pthread_t id;
-    int       exists;
-};
-
 typedef struct ThisFilter
 {
     VideoFilter vf;
 
-    struct DeintThread *threads;
-    VideoFrame *frame;
-    int         field;
-    int         ready;
-    int         kill_threads;
-    int         actual_threads;
-    int         requested_threads;
-    pthread_mutex_t mutex;
+    SliceThreads slices;
+    VideoFrame  *frame;
+    int          field;
 
     int       skipchroma;
     int       mm_flags;
@@ -417,37 +405,16 @@ static void filter_func(struct ThisFilter *p, uint8_t *dst, int dst_offsets[3],
 #endif
 }
 
-static void *KernelThread(void *args)
+static void KernelSlice(void *ctx, int this_slice, int total_slices)
 {
-    ThisFilter *filter = (ThisFilter*)args;
-
-    pthread_mutex_lock(&(filter->mutex));
-    int num = filter->actual_threads;
-    filter->actual_threads = num + 1;
-    pthread_mutex_unlock(&(filter->mutex));
-
-    while (!filter->kill_threads)
-    {
-        usleep(1000);
-        if (filter->ready &&
-            filter->frame != NULL &&
-            filter->threads[num].ready)
-        {
-            filter_func(
-                filter, filter->frame->buf, filter->frame->offsets,
-                filter->frame->pitches, filter->frame->width,
-                filter->frame->height, filter->field,
-                filter->frame->top_field_first, filter->double_rate,
-                filter->dirty_frame, num, filter->actual_threads);
-
-            pthread_mutex_lock(&(filter->mutex));
-            filter->ready = filter->ready - 1;
-            filter->threads[num].ready = 0;
-            pthread_mutex_unlock(&(filter->mutex));
-        }
-    }
-    pthread_exit(NULL);
-    return NULL;
+    ThisFilter *filter = (ThisFilter*)ctx;
+    VideoFrame *frame  = filter->frame;
+
+    filter_func(
+        filter, frame->buf, frame->offsets, frame->pitches,
+        frame->width, frame->height, filter->field,
+        frame->top_field_first, filter->double_rate,
+        filter->dirty_frame, this_slice, total_slices);
 }
 
 static int KernelDeint(VideoFilter *f, VideoFrame *frame, int field)
@@ -480,20 +447,11 @@ static int KernelDeint(VideoFilter *f, VideoFrame *frame, int field)
         }
     }
 
-    if (filter->actual_threads > 1 && filter->double_rate)
+    if (filter->double_rate)
     {
-        int i;
-        for (i = 0; i < filter->actual_threads; i++)
-            filter->threads[i].ready = 1;
         filter->frame = frame;
         filter->field = field;
-        filter->ready = filter->actual_threads;
-        i = 0;
-        while (filter->ready > 0 && i < 1000)
-        {
-            usleep(1000);
-            i++;
-        }
+        SliceThreadsRun(&filter->slices);
     }
     else
     {
@@ -523,14 +481,7 @@ static void CleanupKernelDeintFilter(VideoFilter *f)
         *p= NULL;
     }
 
-    if (filter->threads != NULL)
-    {
-        filter->kill_threads = 1;
-        for (i = 0; i < filter->requested_threads; i++)
-            if (filter->threads[i].exists)
-                pthread_join(filter->threads[i].id, NULL);
-        free(filter->threads);
-    }
+    SliceThreadsCleanup(&filter->slices);
 }
 
 static VideoFilter *NewKernelDeintFilter(VideoFrameType inpixfmt,
@@ -541,7 +492,6 @@ static VideoFilter *NewKernelDeintFilter(VideoFrameType inpixfmt,
     ThisFilter *filter;
     (void) options;
     (void) height;
-    (void) threads;
 
     if (inpixfmt != FMT_YV12 || outpixfmt != FMT_YV12)
     {
@@ -590,67 +540,22 @@ static VideoFilter *NewKernelDeintFilter(VideoFrameType inpixfmt,
 
     filter->frame = NULL;
     filter->field = 0;
-    filter->ready = 0;
-    filter->kill_threads = 0;
-    filter->actual_threads  = 0;
-    filter->requested_threads  = threads;
-    filter->threads = NULL; 
 
-    if (filter->requested_threads > 1)
+    int slices = SliceThreadsInit(&filter->slices, threads,
+                                  KernelSlice, filter);
+    if (slices < threads)
     {
-        filter->threads = (struct DeintThread *) calloc(threads,
-                          sizeof(struct DeintThread));
-        if (filter->threads == NULL)
-        {
-            LOG(VB_GENERAL, LOG_ERR, "KernelDeint: failed to allocate memory "
-                    "for threads - falling back to existing, single thread.");
-            filter->requested_threads = 1;
-        }
+        LOG(VB_GENERAL, LOG_NOTICE,
+            "KernelDeint: only using %d of %d threads", slices, threads);
     }
-
-    if (filter->requested_threads > 1)
+    else if (slices > 1)
     {
-        pthread_mutex_init(&(filter->mutex), NULL);
-        int success = 0;
-        for (int i = 0; i < filter->requested_threads; i++)
-        {
-            if (pthread_create(&(filter->threads[i].id), NULL,
-                               KernelThread, (void*)filter) != 0)
-                filter->threads[i].exists = 0;
-            else
-            {
-                success++;
-                filter->threads[i].exists = 1;
-            }
-        }
-
-        if (success < filter->requested_threads)
-        {
-            LOG(VB_GENERAL, LOG_NOTICE,
-                "KernelDeint: failed to create all threads - "
-                "falling back to existing, single thread.");
-        }
-        else
-        {
-            int timeout = 0;
-            while (filter->actual_threads != filter->requested_threads)
-            {
-                timeout++;
-                if (timeout > 5000)
-                {
-                    LOG(VB_GENERAL, LOG_NOTICE,
-                        "KernelDeint: waited too long for "
-                        "threads to start.- continuing.");
-                    break;
-                }
-                usleep(1000);
-            }
-            LOG(VB_PLAYBACK, LOG_INFO, "KernelDeint: Created threads.");
-        }
+        LOG(VB_PLAYBACK, LOG_INFO, "KernelDeint: Created threads.");
     }
-
-    if (filter->actual_threads < 1 )
+    else
+    {
         LOG(VB_PLAYBACK, LOG_INFO, "KernelDeint: Using existing thread.");
+    }
 
     return (VideoFilter *) filter;
 }
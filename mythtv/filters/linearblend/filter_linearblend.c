@@ -2,6 +2,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "mythconfig.h"
 #if HAVE_STDINT_H
@@ -16,12 +17,16 @@
 #if HAVE_ALTIVEC_H
     #include <altivec.h>
 #endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #define PAVGB(a,b)   "pavgb " #a ", " #b " \n\t"
 #define PAVGUSB(a,b) "pavgusb " #a ", " #b " \n\t"
 
 #include "filter.h"
 #include "mythframe.h"
+#include "../slicethreads.h"
 
 typedef struct LBFilter
 {
@@ -30,12 +35,23 @@ typedef struct LBFilter
     /* functions and variables below here considered "private" */
     int mm_flags;
     void (*subfilter)(unsigned char *, int);
+    void (*subfilter16)(unsigned char *, int); /* 16 columns, may be NULL */
+
+    SliceThreads   slices;
+    int            nslices;
+    VideoFrame    *frame;
+    /* Per slice, 10 rows of each plane to blend the last block of the
+       slice with the rows of the next slice as they were before it
+       started.  That keeps the output identical to a single thread. */
+    unsigned char *scratch;
+    int            scratch_size;
     TF_STRUCT;
 } LBFilter;
 
 void linearBlend(unsigned char *src, int stride);
 void linearBlendMMX(unsigned char *src, int stride);
 void linearBlend3DNow(unsigned char *src, int stride);
+void linearBlendSSE2(unsigned char *src, int stride);
 int linearBlendFilterAltivec(VideoFilter *f, VideoFrame *frame, int field);
 
 #if HAVE_ALTIVEC
@@ -140,6 +156,27 @@ void linearBlend3DNow(unsigned char *src, int stride)
 
 #endif
 
+#ifdef __SSE2__
+
+/* Same as linearBlendMMX, pavgb rounding included, 16 columns at once. */
+void linearBlendSSE2(unsigned char *src, int stride)
+{
+    __m128i l0 = _mm_loadu_si128((__m128i *)(src));
+    __m128i l1 = _mm_loadu_si128((__m128i *)(src + stride));
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        __m128i l2 = _mm_loadu_si128((__m128i *)(src + (i + 2) * stride));
+        _mm_storeu_si128((__m128i *)(src + i * stride),
+                         _mm_avg_epu8(_mm_avg_epu8(l0, l2), l1));
+        l0 = l1;
+        l1 = l2;
+    }
+}
+
+#endif /* __SSE2__ */
+
 #if HAVE_ALTIVEC
 
 inline void linearBlendAltivec(unsigned char *src, int stride)
@@ -284,55 +321,134 @@ void linearBlend(unsigned char *src, int stride)
     }
 }
 
-static int linearBlendFilter(VideoFilter *f, VideoFrame *frame, int  field)
+static void linearBlendRow(LBFilter *vf, unsigned char *src, int stride)
 {
-    (void)field;
-    int height = frame->height;
-    unsigned char *yptr = frame->buf + frame->offsets[0];
-    int stride = frame->pitches[0];
-    int ymax = height - 8;
-    int x,y;
-    unsigned char *src;
-    unsigned char *uoff = frame->buf + frame->offsets[1];
-    unsigned char *voff = frame->buf + frame->offsets[2];
-    LBFilter *vf = (LBFilter *)f;
-    TF_VARS;
+    int x = 0;
 
-    TF_START;
+    if (vf->subfilter16)
+    {
+        for (; x + 16 <= stride; x += 16)
+            (vf->subfilter16)(src + x, stride);
+    }
+    for (; x < stride; x += 8)
+        (vf->subfilter)(src + x, stride);
+}
+
+/* Splits the 8 line blocks of a plane evenly between the slices. */
+static void sliceBlocks(int ymax, int this_slice, int total_slices,
+                        int *first, int *last, int *blocks)
+{
+    *blocks = (ymax > 0) ? (ymax + 7) / 8 : 0;
+    *first  = *blocks * this_slice / total_slices;
+    *last   = *blocks * (this_slice + 1) / total_slices;
+}
 
-    for (y = 0; y < ymax; y+=8)
-    {  
-        for (x = 0; x < stride; x+=8)
+static void planeSize(VideoFrame *frame, int plane, int *stride, int *ymax)
+{
+    *stride = frame->pitches[plane];
+    *ymax   = (plane ? frame->height / 2 : frame->height) - 8;
+}
+
+/* Every block also reads the first two lines of the block below it.
+   Save those of the block following each slice before any slice runs. */
+static void saveSliceEdges(LBFilter *vf, VideoFrame *frame)
+{
+    int i, k, stride, ymax, first, last, blocks;
+
+    for (k = 0; k < vf->nslices - 1; k++)
+    {
+        unsigned char *scratch = vf->scratch + k * vf->scratch_size;
+        for (i = 0; i < 3; i++)
         {
-            src = yptr + x + y * stride;
-            (vf->subfilter)(src, stride);  
+            planeSize(frame, i, &stride, &ymax);
+            sliceBlocks(ymax, k, vf->nslices, &first, &last, &blocks);
+            if (first < last && last < blocks)
+            {
+                memcpy(scratch + 8 * stride,
+                       frame->buf + frame->offsets[i] + last * 8 * stride,
+                       2 * stride);
+            }
+            scratch += 10 * stride;
         }
     }
- 
-    stride = frame->pitches[1];
-    ymax = height / 2 - 8;
-  
-    for (y = 0; y < ymax; y += 8)
+}
+
+static void linearBlendSlice(void *ctx, int this_slice, int total_slices)
+{
+    LBFilter *vf = (LBFilter *)ctx;
+    VideoFrame *frame = vf->frame;
+    unsigned char *scratch = vf->scratch + this_slice * vf->scratch_size;
+    int i, b, stride, ymax, first, last, blocks;
+
+    for (i = 0; i < 3; i++)
     {
-        for (x = 0; x < stride; x += 8)
+        unsigned char *plane = frame->buf + frame->offsets[i];
+
+        planeSize(frame, i, &stride, &ymax);
+        sliceBlocks(ymax, this_slice, total_slices, &first, &last, &blocks);
+
+        for (b = first; b < last; b++)
         {
-            src = uoff + x + y * stride;
-            (vf->subfilter)(src, stride);
-       
-            src = voff + x + y * stride;
-            (vf->subfilter)(src, stride);
+            unsigned char *src = plane + b * 8 * stride;
+            if (b == last - 1 && last < blocks)
+            {
+                memcpy(scratch, src, 8 * stride);
+                linearBlendRow(vf, scratch, stride);
+                memcpy(src, scratch, 8 * stride);
+            }
+            else
+            {
+                linearBlendRow(vf, src, stride);
+            }
         }
+        scratch += 10 * stride;
     }
 
 #if HAVE_MMX || HAVE_AMD3DNOW
     if ((vf->mm_flags & AV_CPU_FLAG_MMX2) || (vf->mm_flags & AV_CPU_FLAG_3DNOW))
         emms();
 #endif
+}
+
+static int linearBlendFilter(VideoFilter *f, VideoFrame *frame, int  field)
+{
+    (void)field;
+    LBFilter *vf = (LBFilter *)f;
+    TF_VARS;
+
+    TF_START;
+
+    if (vf->nslices > 1)
+    {
+        int size = 10 * (frame->pitches[0] + frame->pitches[1] +
+                         frame->pitches[2]);
+        if (size > vf->scratch_size)
+        {
+            unsigned char *scratch = realloc(vf->scratch, size * vf->nslices);
+            if (!scratch)
+                return -1;
+            vf->scratch      = scratch;
+            vf->scratch_size = size;
+        }
+        saveSliceEdges(vf, frame);
+    }
+
+    vf->frame = frame;
+    SliceThreadsRun(&vf->slices);
 
     TF_END(vf, "LinearBlend: ");
     return 0;
 }
 
+static void cleanup(VideoFilter *f)
+{
+    LBFilter *vf = (LBFilter *)f;
+
+    SliceThreadsCleanup(&vf->slices);
+    free(vf->scratch);
+    vf->scratch = NULL;
+}
+
 static VideoFilter *new_filter(VideoFrameType inpixfmt,
                                VideoFrameType outpixfmt,
                                int *width, int *height, char *options,
@@ -342,7 +458,6 @@ static VideoFilter *new_filter(VideoFrameType inpixfmt,
     (void)width;
     (void)height;
     (void)options;
-    (void)threads;
     if (inpixfmt != FMT_YV12 || outpixfmt != FMT_YV12)
         return NULL;
 
@@ -356,15 +471,28 @@ static VideoFilter *new_filter(VideoFrameType inpixfmt,
 
     filter->vf.filter = &linearBlendFilter;
     filter->subfilter = &linearBlend;    /* Default, non accellerated */
+    filter->subfilter16 = NULL;
     filter->mm_flags = av_get_cpu_flags();
     if (HAVE_MMX && filter->mm_flags & AV_CPU_FLAG_MMX2)
+    {
         filter->subfilter = &linearBlendMMX;
+#ifdef __SSE2__
+        if (filter->mm_flags & AV_CPU_FLAG_SSE2)
+            filter->subfilter16 = &linearBlendSSE2;
+#endif
+    }
     else if (HAVE_AMD3DNOW && filter->mm_flags & AV_CPU_FLAG_3DNOW)
         filter->subfilter = &linearBlend3DNow;
     else if (HAVE_ALTIVEC && filter->mm_flags & AV_CPU_FLAG_ALTIVEC)
         filter->vf.filter = &linearBlendFilterAltivec;
 
-    filter->vf.cleanup = NULL;
+    filter->frame = NULL;
+    filter->scratch = NULL;
+    filter->scratch_size = 0;
+    filter->nslices = SliceThreadsInit(&filter->slices, threads,
+                                       &linearBlendSlice, filter);
+
+    filter->vf.cleanup = &cleanup;
     TF_INIT(filter);
     return (VideoFilter *)filter;
 }
@@ -0,0 +1,152 @@
+/* slicethreads.h - Split a frame into horizontal slices across threads
+ *
+ * Each filter keeps one SliceThreads.  SliceThreadsRun() hands every
+ * worker its slice, processes the last slice on the calling thread and
+ * returns once all slices are done.  Workers sleep on a condition
+ * variable between frames, so there is no polling latency per frame.
+ */
+
+#ifndef SLICETHREADS_H
+#define SLICETHREADS_H
+
+#include <stdlib.h>
+#include <pthread.h>
+
+typedef void (*SliceFunc)(void *ctx, int this_slice, int total_slices);
+
+typedef struct SliceThreads SliceThreads;
+
+typedef struct SliceWorker
+{
+    SliceThreads *pool;
+    pthread_t     id;
+    int           num;
+} SliceWorker;
+
+struct SliceThreads
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  wake;     ///< signalled when a frame is ready
+    pthread_cond_t  done;     ///< signalled when the last worker finishes
+    SliceWorker    *workers;
+    int             count;    ///< number of running workers
+    unsigned int    job;      ///< incremented for every frame
+    int             pending;  ///< workers still busy with this frame
+    int             quit;
+
+    SliceFunc       func;
+    void           *ctx;
+};
+
+static void *SliceThreadsWorker(void *arg)
+{
+    SliceWorker  *worker = (SliceWorker*)arg;
+    SliceThreads *pool   = worker->pool;
+    unsigned int  job    = 0;
+
+    pthread_mutex_lock(&pool->mutex);
+    while (1)
+    {
+        while (!pool->quit && pool->job == job)
+            pthread_cond_wait(&pool->wake, &pool->mutex);
+        if (pool->quit)
+            break;
+        job = pool->job;
+        pthread_mutex_unlock(&pool->mutex);
+
+        pool->func(pool->ctx, worker->num, pool->count + 1);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pending == 0)
+            pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+
+/** Starts threads - 1 workers, the caller processes the last slice.
+ *  Returns the number of slices frames will be split into, 1 if no
+ *  workers could be started.
+ */
+static int SliceThreadsInit(SliceThreads *pool, int threads,
+                            SliceFunc func, void *ctx)
+{
+    int i;
+
+    pool->workers = NULL;
+    pool->count   = 0;
+    pool->job     = 0;
+    pool->pending = 0;
+    pool->quit    = 0;
+    pool->func    = func;
+    pool->ctx     = ctx;
+
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    if (threads < 2)
+        return 1;
+
+    pool->workers = (SliceWorker*)calloc(threads - 1, sizeof(SliceWorker));
+    if (!pool->workers)
+        return 1;
+
+    for (i = 0; i < threads - 1; i++)
+    {
+        pool->workers[i].pool = pool;
+        pool->workers[i].num  = i;
+        if (pthread_create(&pool->workers[i].id, NULL,
+                           SliceThreadsWorker, &pool->workers[i]) != 0)
+            break;
+        pool->count++;
+    }
+
+    return pool->count + 1;
+}
+
+/// Runs func on every slice of the current frame and waits for them.
+static void SliceThreadsRun(SliceThreads *pool)
+{
+    if (pool->count < 1)
+    {
+        pool->func(pool->ctx, 0, 1);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->pending = pool->count;
+    pool->job++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
+
+    pool->func(pool->ctx, pool->count, pool->count + 1);
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->pending > 0)
+        pthread_cond_wait(&pool->done, &pool->mutex);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+static void SliceThreadsCleanup(SliceThreads *pool)
+{
+    int i;
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->quit = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (i = 0; i < pool->count; i++)
+        pthread_join(pool->workers[i].id, NULL);
+    free(pool->workers);
+    pool->workers = NULL;
+    pool->count   = 0;
+
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->mutex);
+}
+
+#endif /* SLICETHREADS_H */
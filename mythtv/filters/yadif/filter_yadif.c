@@ -31,7 +31,6 @@
 
 #include <string.h>
 #include <math.h>
-#include <pthread.h>
 
 #include "filter.h"
 #include "mythframe.h"
@@ -49,28 +48,17 @@
 #endif
 
 #include "aclib.h"
+#include "../slicethreads.h"
 
 static void* (*fast_memcpy)(void * to, const void * from, size_t len);
 
-struct DeintThread
-{
-    int       ready;
-    pthread_t id;
-    int       exists;
-};
-
 typedef struct ThisFilter
 {
     VideoFilter vf;
 
-    struct DeintThread *threads;
-    VideoFrame *frame;
-    int         field;
-    int         ready;
-    int         kill_threads;
-    int         actual_threads;
-    int         requested_threads;
-    pthread_mutex_t mutex;
+    SliceThreads slices;
+    VideoFrame  *frame;
+    int          field;
 
     long long last_framenr;
 
@@ -507,28 +495,9 @@ static int YadifDeint (VideoFilter * f, VideoFrame * frame, int field)
                   frame->pitches, frame->width, frame->height);
     }
 
-    if (filter->actual_threads < 1)
-    {
-        filter_func(
-            filter, frame->buf, frame->offsets, frame->pitches,
-            frame->width, frame->height, field, frame->top_field_first,
-            0, 1);
-    }
-    else
-    {
-        int i;
-        for (i = 0; i < filter->actual_threads; i++)
-            filter->threads[i].ready = 1;
-        filter->field = field;
-        filter->frame = frame;
-        filter->ready = filter->actual_threads;
-        i = 0;
-        while (filter->ready > 0 && i < 1000)
-        {
-            usleep(1000);
-            i++;
-        }
-    }
+    filter->field = field;
+    filter->frame = frame;
+    SliceThreadsRun(&filter->slices);
 
     filter->last_framenr = frame->frameNumber;
 
@@ -541,14 +510,7 @@ static void CleanupYadifDeintFilter (VideoFilter * filter)
     int i;
     ThisFilter* f = (ThisFilter*)filter;
 
-    if (f->threads != NULL)
-    {
-        f->kill_threads = 1;
-        for (i = 0; i < f->requested_threads; i++)
-            if (f->threads[i].exists)
-                pthread_join(f->threads[i].id, NULL);
-        free(f->threads);
-    }
+    SliceThreadsCleanup(&f->slices);
 
     for (i = 0; i < 3*3; i++)
     {
@@ -558,36 +520,15 @@ static void CleanupYadifDeintFilter (VideoFilter * filter)
     }
 }
 
-static void *YadifThread(void *args)
+static void YadifSlice(void *ctx, int this_slice, int total_slices)
 {
-    ThisFilter *filter = (ThisFilter*)args;
+    ThisFilter *filter = (ThisFilter*)ctx;
+    VideoFrame *frame  = filter->frame;
 
-    pthread_mutex_lock(&(filter->mutex));
-    int num = filter->actual_threads;
-    filter->actual_threads = num + 1;
-    pthread_mutex_unlock(&(filter->mutex));
-
-    while (!filter->kill_threads)
-    {
-        usleep(1000);
-        if (filter->ready &&
-            filter->frame != NULL &&
-            filter->threads[num].ready)
-        {
-            filter_func(
-                filter, filter->frame->buf, filter->frame->offsets,
-                filter->frame->pitches, filter->frame->width,
-                filter->frame->height, filter->field,
-                filter->frame->top_field_first, num, filter->actual_threads);
-
-            pthread_mutex_lock(&(filter->mutex));
-            filter->ready = filter->ready - 1;
-            filter->threads[num].ready = 0;
-            pthread_mutex_unlock(&(filter->mutex));
-        }
-    }
-    pthread_exit(NULL);
-    return NULL;
+    filter_func(
+        filter, frame->buf, frame->offsets, frame->pitches,
+        frame->width, frame->height, filter->field,
+        frame->top_field_first, this_slice, total_slices);
 }
 
 static VideoFilter * YadifDeintFilter(VideoFrameType inpixfmt,
@@ -646,68 +587,17 @@ static VideoFilter * YadifDeintFilter(VideoFrameType inpixfmt,
 
     filter->frame = NULL;
     filter->field = 0;
-    filter->ready = 0;
-    filter->kill_threads = 0;
-    filter->actual_threads  = 0;
-    filter->requested_threads  = threads;
-    filter->threads = NULL;
 
-    if (filter->requested_threads > 1)
+    int slices = SliceThreadsInit(&filter->slices, threads,
+                                  YadifSlice, filter);
+    if (slices < threads)
     {
-        filter->threads = (struct DeintThread *) calloc(threads,
-                          sizeof(struct DeintThread));
-        if (filter->threads == NULL)
-        {
-            printf("YadifDeint: failed to allocate memory for threads - "
-                   "falling back to existing, single thread.\n");
-            filter->requested_threads = 1;
-        }
+        printf("YadifDeint: only using %d of %d threads\n",
+               slices, threads);
     }
-
-    if (filter->requested_threads > 1)
-    {
-        pthread_mutex_init(&(filter->mutex), NULL);
-        int success = 0;
-        for (int i = 0; i < filter->requested_threads; i++)
-        {
-            if (pthread_create(&(filter->threads[i].id), NULL,
-                               YadifThread, (void*)filter) != 0)
-                filter->threads[i].exists = 0;
-            else
-            {
-                success++;
-                filter->threads[i].exists = 1;
-            }
-        }
-
-        if (success < filter->requested_threads)
-        {
-            printf("YadifDeint: only created %d of %d threads - "
-                   "falling back to existing, single thread.\n"
-                   , success, filter->requested_threads);
-        }
-        else
-        {
-            int timeout = 0;
-            while (filter->actual_threads != filter->requested_threads)
-            {
-                timeout++;
-                if (timeout > 5000)
-                {
-                    printf("YadifDeint: waited too long for threads to start."
-                           "- continuing.\n");
-                    break;
-                }
-                usleep(1000);
-            }
-            printf("yadifdeint: Created %d threads (%d requested)\n",
-                   filter->actual_threads, filter->requested_threads);
-        }
-    }
-
-    if (filter->actual_threads < 1 )
+    else if (slices > 1)
     {
-        printf("YadifDeint: Using existing thread.\n");
+        printf("yadifdeint: Created %d threads\n", slices - 1);
     }
 
     return (VideoFilter *) filter;
@@ -164,44 +164,72 @@ static const float s51_matrix[3][8][6] =
     }
 };
 
+/**
+ * Downmixes interleaved frames of CH_IN channels to CH_OUT channels.
+ *
+ * With the channel counts known at compile time the compiler unrolls both
+ * channel loops and keeps the coefficients in registers, which lets it
+ * vectorise the mixing.  The sums are done in the same order as before.
+ */
+template <int CH_IN, int CH_OUT>
+static void DownmixFixed(const float coeff[][CH_OUT],
+                         float *dst, const float *src, int frames)
+{
+    float c[CH_IN][CH_OUT];
+    for (int j = 0; j < CH_IN; j++)
+        for (int i = 0; i < CH_OUT; i++)
+            c[j][i] = coeff[j][i];
+
+    for (int n = 0; n < frames; n++)
+    {
+        // The whole frame is read before any of it is written, AudioOutputBase
+        // downmixes in place.
+        float out[CH_OUT];
+        for (int i = 0; i < CH_OUT; i++)
+        {
+            out[i] = 0.0f;
+            for (int j = 0; j < CH_IN; j++)
+                out[i] += src[j] * c[j][i];
+        }
+        for (int i = 0; i < CH_OUT; i++)
+            dst[i] = out[i];
+        src += CH_IN;
+        dst += CH_OUT;
+    }
+}
+
 int AudioOutputDownmix::DownmixFrames(int channels_in, int  channels_out,
                                       float *dst, float *src, int frames)
 {
-    if (channels_in < channels_out)
+    if (channels_in < channels_out || channels_in > 8)
         return -1;
 
     //VBAUDIO(LOC + QString("Downmixing %1 frames (in:%2 out:%3)")
     //    .arg(frames).arg(channels_in).arg(channels_out));
     if (channels_out == 2)
     {
-        float tmp;
-        int index = channels_in - 1;
-        for (int n=0; n < frames; n++)
+        const float (*coeff)[2] = stereo_matrix[channels_in - 1];
+        switch (channels_in)
         {
-            for (int i=0; i < channels_out; i++)
-            {
-                tmp = 0.0f;
-                for (int j=0; j < channels_in; j++)
-                    tmp += src[j] * stereo_matrix[index][j][i];
-                *dst++ = tmp;
-            }
-            src += channels_in;
+            case 2: DownmixFixed<2,2>(coeff, dst, src, frames); break;
+            case 3: DownmixFixed<3,2>(coeff, dst, src, frames); break;
+            case 4: DownmixFixed<4,2>(coeff, dst, src, frames); break;
+            case 5: DownmixFixed<5,2>(coeff, dst, src, frames); break;
+            case 6: DownmixFixed<6,2>(coeff, dst, src, frames); break;
+            case 7: DownmixFixed<7,2>(coeff, dst, src, frames); break;
+            case 8: DownmixFixed<8,2>(coeff, dst, src, frames); break;
+            default: return -1;
         }
     }
     else if (channels_out == 6)
     {
-        float tmp;
-        int index = channels_in - 6;
-        for (int n=0; n < frames; n++)
+        const float (*coeff)[6] = s51_matrix[channels_in - 6];
+        switch (channels_in)
         {
-            for (int i=0; i < channels_out; i++)
-            {
-                tmp = 0.0f;
-                for (int j=0; j < channels_in; j++)
-                    tmp += src[j] * s51_matrix[index][j][i];
-                *dst++ = tmp;
-            }
-            src += channels_in;
+            case 6: DownmixFixed<6,6>(coeff, dst, src, frames); break;
+            case 7: DownmixFixed<7,6>(coeff, dst, src, frames); break;
+            case 8: DownmixFixed<8,6>(coeff, dst, src, frames); break;
+            default: return -1;
         }
     }
     else
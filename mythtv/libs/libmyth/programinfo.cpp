@@ -19,6 +19,7 @@ using std::deque;
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
+#include <QSet>
 
 // MythTV headers
 #include "programinfoupdater.h"
@@ -83,6 +84,35 @@ static void set_flag(uint32_t &flags, int flag_to_set, bool is_set)
         flags |= flag_to_set;
 }
 
+/** \brief Returns a copy of str that shares its data with every other
+ *         ProgramInfo holding the same text.
+ *
+ *   Channels, hosts and groups repeat across the thousands of
+ *   ProgramInfo instances the scheduler and the recordings lists hold.
+ *   Each one loaded from the database or a string list would otherwise
+ *   carry its own copy of the text.  The pool is never emptied, so only
+ *   use it for fields with few distinct values, not titles.
+ */
+static QString intern_string(const QString &str)
+{
+    static const int kMaxInternedStrings = 50000;
+    static QMutex lock;
+    static QSet<QString> strings;
+
+    if (str.isEmpty())
+        return str;
+
+    QMutexLocker locker(&lock);
+    QSet<QString>::const_iterator it = strings.constFind(str);
+    if (it != strings.constEnd())
+        return *it;
+
+    if (strings.size() < kMaxInternedStrings)
+        strings.insert(str);
+
+    return str;
+}
+
 QString myth_category_type_to_string(ProgramInfo::CategoryType category_type)
 {
     static int NUM_CAT_TYPES = 5;
@@ -130,13 +160,13 @@ ProgramInfo::ProgramInfo(void) :
     channame(),
     chanplaybackfilters(),
 
-    recgroup("Default"),
-    playgroup("Default"),
+    recgroup(intern_string("Default")),
+    playgroup(intern_string("Default")),
 
     pathname(),
 
     hostname(),
-    storagegroup("Default"),
+    storagegroup(intern_string("Default")),
 
     seriesid(),
     programid(),
@@ -394,18 +424,18 @@ ProgramInfo::ProgramInfo(
     recpriority(_recpriority),
 
     chanid(_chanid),
-    chanstr(_channum),
-    chansign(_chansign),
-    channame(_channame),
-    chanplaybackfilters(_chanplaybackfilters),
+    chanstr(intern_string(_channum)),
+    chansign(intern_string(_chansign)),
+    channame(intern_string(_channame)),
+    chanplaybackfilters(intern_string(_chanplaybackfilters)),
 
-    recgroup(_recgroup),
-    playgroup(_playgroup),
+    recgroup(intern_string(_recgroup)),
+    playgroup(intern_string(_playgroup)),
 
     pathname(_pathname),
 
-    hostname(_hostname),
-    storagegroup(_storagegroup),
+    hostname(intern_string(_hostname)),
+    storagegroup(intern_string(_storagegroup)),
 
     seriesid(_seriesid),
     programid(_programid),
@@ -514,18 +544,18 @@ ProgramInfo::ProgramInfo(
     recpriority(0),
 
     chanid(_chanid),
-    chanstr(_channum),
-    chansign(_chansign),
-    channame(_channame),
+    chanstr(intern_string(_channum)),
+    chansign(intern_string(_chansign)),
+    channame(intern_string(_channame)),
     chanplaybackfilters(),
 
-    recgroup("Default"),
-    playgroup("Default"),
+    recgroup(intern_string("Default")),
+    playgroup(intern_string("Default")),
 
     pathname(),
 
     hostname(),
-    storagegroup("Default"),
+    storagegroup(intern_string("Default")),
 
     seriesid(_seriesid),
     programid(_programid),
@@ -643,18 +673,18 @@ ProgramInfo::ProgramInfo(
     recpriority(0),
 
     chanid(_chanid),
-    chanstr(_channum),
-    chansign(_chansign),
-    channame(_channame),
-    chanplaybackfilters(_chanplaybackfilters),
+    chanstr(intern_string(_channum)),
+    chansign(intern_string(_chansign)),
+    channame(intern_string(_channame)),
+    chanplaybackfilters(intern_string(_chanplaybackfilters)),
 
-    recgroup("Default"),
-    playgroup("Default"),
+    recgroup(intern_string("Default")),
+    playgroup(intern_string("Default")),
 
     pathname(),
 
     hostname(),
-    storagegroup("Default"),
+    storagegroup(intern_string("Default")),
 
     seriesid(_seriesid),
     programid(_programid),
@@ -799,18 +829,18 @@ ProgramInfo::ProgramInfo(
     recpriority(0),
 
     chanid(_chanid),
-    chanstr(_channum),
-    chansign(_chansign),
-    channame(_channame),
-    chanplaybackfilters(_chanplaybackfilters),
+    chanstr(intern_string(_channum)),
+    chansign(intern_string(_chansign)),
+    channame(intern_string(_channame)),
+    chanplaybackfilters(intern_string(_chanplaybackfilters)),
 
-    recgroup(_recgroup),
-    playgroup(_playgroup),
+    recgroup(intern_string(_recgroup)),
+    playgroup(intern_string(_playgroup)),
 
     pathname(),
 
     hostname(),
-    storagegroup("Default"),
+    storagegroup(intern_string("Default")),
 
     seriesid(_seriesid),
     programid(_programid),
@@ -1395,6 +1425,7 @@ void ProgramInfo::ToStringList(QStringList &list) const
     } while (0)
 
 #define STR_FROM_LIST(x)     do { NEXT_STR(); (x) = ts; } while (0)
+#define ISTR_FROM_LIST(x)    do { NEXT_STR(); (x) = intern_string(ts); } while (0)
 
 #define FLOAT_FROM_LIST(x)   do { NEXT_STR(); (x) = ts.toFloat(); } while (0)
 
@@ -1427,16 +1458,16 @@ bool ProgramInfo::FromStringList(QStringList::const_iterator &it,
     STR_FROM_LIST(syndicatedepisode); // 6
     STR_FROM_LIST(category);         // 7
     INT_FROM_LIST(chanid);           // 8
-    STR_FROM_LIST(chanstr);          // 9
-    STR_FROM_LIST(chansign);         // 10
-    STR_FROM_LIST(channame);         // 11
+    ISTR_FROM_LIST(chanstr);         // 9
+    ISTR_FROM_LIST(chansign);        // 10
+    ISTR_FROM_LIST(channame);        // 11
     STR_FROM_LIST(pathname);         // 12
     INT_FROM_LIST(filesize);         // 13
 
     DATETIME_FROM_LIST(startts);     // 14
     DATETIME_FROM_LIST(endts);       // 15
     INT_FROM_LIST(findid);           // 16
-    STR_FROM_LIST(hostname);         // 17
+    ISTR_FROM_LIST(hostname);        // 17
     INT_FROM_LIST(sourceid);         // 18
     INT_FROM_LIST(cardid);           // 19
     INT_FROM_LIST(inputid);          // 20
@@ -1450,8 +1481,8 @@ bool ProgramInfo::FromStringList(QStringList::const_iterator &it,
     DATETIME_FROM_LIST(recstartts);   // 27
     DATETIME_FROM_LIST(recendts);     // 28
     INT_FROM_LIST(programflags);      // 29
-    STR_FROM_LIST(recgroup);          // 30
-    STR_FROM_LIST(chanplaybackfilters);//31
+    ISTR_FROM_LIST(recgroup);         // 30
+    ISTR_FROM_LIST(chanplaybackfilters); // 31
     STR_FROM_LIST(seriesid);          // 32
     STR_FROM_LIST(programid);         // 33
     STR_FROM_LIST(inetref);           // 34
@@ -1459,10 +1490,10 @@ bool ProgramInfo::FromStringList(QStringList::const_iterator &it,
     DATETIME_FROM_LIST(lastmodified); // 35
     FLOAT_FROM_LIST(stars);           // 36
     DATE_FROM_LIST(originalAirDate);; // 37
-    STR_FROM_LIST(playgroup);         // 38
+    ISTR_FROM_LIST(playgroup);        // 38
     INT_FROM_LIST(recpriority2);      // 39
     INT_FROM_LIST(parentid);          // 40
-    STR_FROM_LIST(storagegroup);      // 41
+    ISTR_FROM_LIST(storagegroup);     // 41
     uint audioproperties, videoproperties, subtitleType;
     INT_FROM_LIST(audioproperties);   // 42
     INT_FROM_LIST(videoproperties);   // 43
@@ -22,6 +22,8 @@
 
 #include "mythcorecontext.h"
 #include "audioconvert.h"
+#include "audiooutputdownmix.h"
+#include "audiooutpututil.h"
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
 #define MSKIP(MSG) QSKIP(MSG, SkipSingle)
@@ -35,6 +37,8 @@
 
 #define ISIZEOF(type) ((int)sizeof(type))
 
+#define BENCH_FRAMES 48000  // one second of audio
+
 class TestAudioConvert: public QObject
 {
     Q_OBJECT
@@ -597,4 +601,140 @@ class TestAudioConvert: public QObject
         av_free(arrays2);
         av_free(arrayf1);
     }
+
+    // a single channel at a time must land where the mixing matrix says,
+    // also when downmixing in place as AudioOutputBase does
+    void DownmixMatrix_data(void)
+    {
+        QTest::addColumn<int>("IN");
+        QTest::addColumn<int>("CHANNEL");
+        QTest::addColumn<float>("LEFT");
+        QTest::addColumn<float>("RIGHT");
+        QTest::newRow("5.1 L")   << 6 << 0 << 1.0f << 0.0f;
+        QTest::newRow("5.1 R")   << 6 << 1 << 0.0f << 1.0f;
+        QTest::newRow("5.1 C")   << 6 << 2 << 0.7071068f << 0.7071068f;
+        QTest::newRow("5.1 LFE") << 6 << 3 << 0.0f << 0.0f;
+        QTest::newRow("5.1 LS")  << 6 << 4 << 0.8164966f << -0.5773503f;
+        QTest::newRow("7.1 RS")  << 8 << 7 << 0.4082483f << 0.5773503f;
+    }
+
+    void DownmixMatrix(void)
+    {
+        QFETCH(int, IN);
+        QFETCH(int, CHANNEL);
+        QFETCH(float, LEFT);
+        QFETCH(float, RIGHT);
+
+        const int FRAMES = 64;
+        float *buffer = (float*)av_malloc(FRAMES * IN * ISIZEOF(float));
+        for (int n = 0; n < FRAMES; n++)
+            for (int c = 0; c < IN; c++)
+                buffer[n * IN + c] = (c == CHANNEL) ? 1.0f : 0.0f;
+
+        QCOMPARE(AudioOutputDownmix::DownmixFrames(IN, 2, buffer, buffer,
+                                                   FRAMES), FRAMES);
+        for (int n = 0; n < FRAMES; n++)
+        {
+            QVERIFY(qAbs(buffer[n * 2]     - LEFT)  < 1e-6f);
+            QVERIFY(qAbs(buffer[n * 2 + 1] - RIGHT) < 1e-6f);
+        }
+
+        av_free(buffer);
+    }
+
+    void DownmixRejectsLayouts(void)
+    {
+        float buffer[16];
+        QCOMPARE(AudioOutputDownmix::DownmixFrames(2, 6, buffer, buffer, 1), -1);
+        QCOMPARE(AudioOutputDownmix::DownmixFrames(9, 2, buffer, buffer, 1), -1);
+        QCOMPARE(AudioOutputDownmix::DownmixFrames(8, 4, buffer, buffer, 1), -1);
+    }
+
+    void ConversionSpeed_data(void)
+    {
+        QTest::addColumn<int>("IN");
+        QTest::addColumn<int>("OUT");
+        for (uint i = 0; i < sizeof(fmts) / sizeof(fmts[0]); i++)
+        {
+            for (uint o = 0; o < sizeof(fmts) / sizeof(fmts[0]); o++)
+            {
+                if (i == o)
+                    continue;
+                QString name = QString("%1 to %2")
+                    .arg(AudioOutputSettings::FormatToString(fmts[i]))
+                    .arg(AudioOutputSettings::FormatToString(fmts[o]));
+                QTest::newRow(name.toLatin1().constData())
+                    << (int)fmts[i] << (int)fmts[o];
+            }
+        }
+    }
+
+    // converts one second of 7.1 audio
+    void ConversionSpeed(void)
+    {
+        QFETCH(int, IN);
+        QFETCH(int, OUT);
+
+        int samples = BENCH_FRAMES * 8;
+        int bytes   = samples *
+            AudioOutputSettings::SampleSize((AudioFormat)IN);
+        uchar *in   = (uchar*)av_malloc(samples * ISIZEOF(float));
+        uchar *out  = (uchar*)av_malloc(samples * ISIZEOF(float));
+        for (int i = 0; i < samples * ISIZEOF(float); i++)
+            in[i] = (i * 7) & 0x7f;
+
+        AudioConvert ac((AudioFormat)IN, (AudioFormat)OUT);
+        QBENCHMARK
+        {
+            ac.Process(out, in, bytes);
+        }
+
+        av_free(in);
+        av_free(out);
+    }
+
+    void DownmixSpeed_data(void)
+    {
+        QTest::addColumn<int>("IN");
+        QTest::addColumn<int>("OUT");
+        QTest::newRow("5.1 to stereo") << 6 << 2;
+        QTest::newRow("7.1 to stereo") << 8 << 2;
+        QTest::newRow("6.1 to 5.1")    << 7 << 6;
+        QTest::newRow("7.1 to 5.1")    << 8 << 6;
+    }
+
+    void DownmixSpeed(void)
+    {
+        QFETCH(int, IN);
+        QFETCH(int, OUT);
+
+        float *in  = (float*)av_malloc(BENCH_FRAMES * IN * ISIZEOF(float));
+        float *out = (float*)av_malloc(BENCH_FRAMES * OUT * ISIZEOF(float));
+        for (int i = 0; i < BENCH_FRAMES * IN; i++)
+            in[i] = (i % 200) / 100.0f - 1.0f;
+
+        QBENCHMARK
+        {
+            AudioOutputDownmix::DownmixFrames(IN, OUT, out, in, BENCH_FRAMES);
+        }
+
+        av_free(in);
+        av_free(out);
+    }
+
+    void VolumeSpeed(void)
+    {
+        int bytes  = BENCH_FRAMES * 8 * ISIZEOF(float);
+        float *buf = (float*)av_malloc(bytes);
+        for (int i = 0; i < BENCH_FRAMES * 8; i++)
+            buf[i] = (i % 200) / 100.0f - 1.0f;
+
+        // a gain just above 1 so repeated runs don't end up in denormals
+        QBENCHMARK
+        {
+            AudioOutputUtil::AdjustVolume(buf, bytes, 82, false, true);
+        }
+
+        av_free(buf);
+    }
 };
@@ -19,6 +19,7 @@
  */
 
 #include <QtTest/QtTest>
+#include <QSet>
 
 #include "mythcorecontext.h"
 #include "programinfo.h"
@@ -30,6 +31,8 @@
 #define MSKIP(MSG) QSKIP(MSG)
 #endif
 
+#define NUM_RECORDINGS 2000
+
 class TestProgramInfo : public QObject
 {
     Q_OBJECT
@@ -75,6 +78,24 @@ class TestProgramInfo : public QObject
         );
     }
 
+    /// Serializes programs the way the backend answers QUERY_RECORDINGS,
+    /// each string is a separate copy as if it came off the socket.
+    QStringList mockRecordingList(int count)
+    {
+        QStringList list;
+        for (int i = 0; i < count; i++)
+        {
+            ProgramInfo program (mockMovie ("", QString("EP%1").arg(i),
+                                            QString("Series %1").arg(i % 50),
+                                            2000));
+            QStringList fields;
+            program.ToStringList (fields);
+            for (int j = 0; j < fields.size(); j++)
+                list << QString (fields[j].constData(), fields[j].size());
+        }
+        return list;
+    }
+
   private slots:
     /**
      * test for https://code.mythtv.org/trac/ticket/12049
@@ -143,4 +164,72 @@ class TestProgramInfo : public QObject
         ProgramInfo programH (mockMovie ("", "", "Gone", 2012));
         QVERIFY (programG.IsSameProgram (programH));
     }
+
+    /**
+     * programs read from a list share the text of their repeated fields
+     */
+    void internedStrings_test(void)
+    {
+        QStringList list = mockRecordingList (51);
+        QStringList::const_iterator it = list.begin();
+        ProgramInfo first (it, list.end());
+        for (int i = 1; i < 50; i++)
+            ProgramInfo skipped (it, list.end());
+        ProgramInfo last (it, list.end());
+
+        QCOMPARE (first.GetTitle(), QString("Series 0"));
+        QCOMPARE (last.GetTitle(), first.GetTitle());
+        QVERIFY (last.GetTitle().constData() == first.GetTitle().constData());
+        QVERIFY (last.GetProgramID().constData() !=
+                 first.GetProgramID().constData());
+    }
+
+    /**
+     * memory used per program and time to build a recordings list
+     */
+    void recordingList_benchmark(void)
+    {
+        QStringList list = mockRecordingList (NUM_RECORDINGS);
+
+        QList<ProgramInfo*> programs;
+        QBENCHMARK
+        {
+            qDeleteAll (programs);
+            programs.clear();
+            QStringList::const_iterator it = list.begin();
+            while (it != list.end())
+                programs << new ProgramInfo (it, list.end());
+        }
+        QCOMPARE (programs.size(), NUM_RECORDINGS);
+
+        // Count string data once however many programs share it
+        QSet<const QChar*> seen;
+        qint64 bytes = 0;
+        for (int i = 0; i < programs.size(); i++)
+        {
+            bytes += sizeof(ProgramInfo);
+            QString strs[] = {
+                programs[i]->GetTitle(), programs[i]->GetSubtitle(),
+                programs[i]->GetDescription(), programs[i]->GetCategory(),
+                programs[i]->GetChanNum(), programs[i]->GetChannelSchedulingID(),
+                programs[i]->GetChannelName(), programs[i]->GetPathname(),
+                programs[i]->GetHostname(), programs[i]->GetRecordingGroup(),
+                programs[i]->GetPlaybackGroup(), programs[i]->GetStorageGroup(),
+                programs[i]->GetSeriesID(), programs[i]->GetProgramID(),
+                programs[i]->GetInetRef(),
+            };
+            for (uint j = 0; j < sizeof(strs) / sizeof(strs[0]); j++)
+            {
+                if (!strs[j].isEmpty() && !seen.contains(strs[j].constData()))
+                {
+                    seen.insert (strs[j].constData());
+                    bytes += strs[j].size() * sizeof(QChar);
+                }
+            }
+        }
+        qDebug ("%d programs, %lld bytes per ProgramInfo",
+                programs.size(), bytes / programs.size());
+
+        qDeleteAll (programs);
+    }
 };
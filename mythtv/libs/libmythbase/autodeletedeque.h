@@ -32,6 +32,7 @@ class AutoDeleteDeque
     }
 
     T take(uint i);
+    iterator insert(iterator it, T info) { return list.insert(it, info); }
     iterator erase(iterator it)
     {
         if (autodelete)
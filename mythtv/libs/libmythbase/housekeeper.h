@@ -154,13 +154,13 @@ class MBASE_PUBLIC HouseKeeper : public QObject
    ~HouseKeeper();
 
     void RegisterTask(HouseKeeperTask *task);
-    void Start(void);
     void StartThread(void);
     HouseKeeperTask* GetQueuedTask(void);
 
     void customEvent(QEvent *e);
 
   public slots:
+    void Start(void);
     void Run(void);
 
   private:
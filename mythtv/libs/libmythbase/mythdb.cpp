@@ -4,9 +4,11 @@ using namespace std;
 #include <QReadWriteLock>
 #include <QTextStream>
 #include <QSqlError>
+#include <QThread>
 #include <QMutex>
 #include <QFile>
 #include <QHash>
+#include <QSet>
 #include <QDir>
 
 #include "mythdb.h"
@@ -68,6 +70,8 @@ class MythDBPrivate
     MythDBPrivate();
    ~MythDBPrivate();
 
+    void CountSettingsQuery(void);
+
     DatabaseParams  m_DBparams;  ///< Current database host & WOL details
     QString m_localhostname;
     MDBManager m_dbmanager;
@@ -81,6 +85,19 @@ class MythDBPrivate
     SettingsMap settingsCache;
     /// Overridden this session only
     SettingsMap overriddenSettings;
+    /// True once LoadSettingsCache() put every setting in settingsCache,
+    /// keys that are not in it then aren't in the database either
+    volatile bool settingsCacheComplete;
+    /// Keys cleared since the cache was loaded, these are looked up again
+    QSet<QString> staleSettings;
+    /// Incremented when the whole cache is cleared
+    uint settingsCacheGeneration;
+    /// Set by the thread loading the cache
+    QAtomicInt settingsCacheLoading;
+
+    /// Settings lookups that went to the database, by thread name
+    QMap<QString,uint> settingsQueries;
+    mutable QMutex settingsQueriesLock;
     /// Settings which should be written to the database as soon as it becomes
     /// available
     QList<SingleSetting> delayedSettings;
@@ -93,7 +110,8 @@ static const int settings_reserve = 61;
 
 MythDBPrivate::MythDBPrivate() :
     ignoreDatabase(false), suppressDBMessages(true), useSettingsCache(false),
-    haveDBConnection(false), haveSchema(false)
+    settingsCacheComplete(false), settingsCacheGeneration(0),
+    settingsCacheLoading(0), haveDBConnection(false), haveSchema(false)
 {
     m_localhostname.clear();
     settingsCache.reserve(settings_reserve);
@@ -101,9 +119,31 @@ MythDBPrivate::MythDBPrivate() :
 
 MythDBPrivate::~MythDBPrivate()
 {
+    QMap<QString,uint>::const_iterator it = settingsQueries.begin();
+    for (; it != settingsQueries.end(); ++it)
+    {
+        LOG(VB_DATABASE, LOG_INFO, QString("%1 settings queries from '%2'")
+            .arg(*it).arg(it.key()));
+    }
+
     LOG(VB_DATABASE, LOG_INFO, "Destroying MythDBPrivate");
 }
 
+void MythDBPrivate::CountSettingsQuery(void)
+{
+    QString name = QThread::currentThread()->objectName();
+    if (name.isEmpty())
+        name = "unnamed";
+
+    QMutexLocker locker(&settingsQueriesLock);
+    uint &count = settingsQueries[name];
+    if ((++count % 1000) == 0)
+    {
+        LOG(VB_DATABASE, LOG_INFO, QString("%1 settings queries from '%2'")
+            .arg(count).arg(name));
+    }
+}
+
 MythDB::MythDB()
 {
     d = new MythDBPrivate();
@@ -366,6 +406,9 @@ QString MythDB::GetSetting(const QString &_key, const QString &defaultval)
     QString key = _key.toLower();
     QString value = defaultval;
 
+    if (d->useSettingsCache && !d->settingsCacheComplete)
+        LoadSettingsCache();
+
     d->settingsCacheLock.lockForRead();
     if (d->useSettingsCache)
     {
@@ -384,15 +427,19 @@ QString MythDB::GetSetting(const QString &_key, const QString &defaultval)
         d->settingsCacheLock.unlock();
         return value;
     }
+    bool missing = d->useSettingsCache && d->settingsCacheComplete &&
+                   !d->staleSettings.contains(key);
     d->settingsCacheLock.unlock();
 
-    if (d->ignoreDatabase || !HaveValidDatabase())
+    if (missing || d->ignoreDatabase || !HaveValidDatabase())
         return value;
 
     MSqlQuery query(MSqlQuery::InitCon());
     if (!query.isConnected())
         return value;
 
+    d->CountSettingsQuery();
+
     query.prepare(
         "SELECT data "
         "FROM settings "
@@ -444,6 +491,9 @@ bool MythDB::GetSettings(QMap<QString,QString> &_key_value_pairs)
     QMap<QString,bool>::iterator dit = done.begin();
     kvit = _key_value_pairs.begin();
 
+    if (d->useSettingsCache && !d->settingsCacheComplete)
+        LoadSettingsCache();
+
     {
         uint done_cnt = 0;
         d->settingsCacheLock.lockForRead();
@@ -471,6 +521,18 @@ bool MythDB::GetSettings(QMap<QString,QString> &_key_value_pairs)
                 done_cnt++;
             }
         }
+        if (d->useSettingsCache && d->settingsCacheComplete)
+        {
+            // The rest are not in the database, keep their defaults
+            for (dit = done.begin(); dit != done.end(); ++dit)
+            {
+                if (!*dit && !d->staleSettings.contains(dit.key()))
+                {
+                    *dit = true;
+                    done_cnt++;
+                }
+            }
+        }
         d->settingsCacheLock.unlock();
 
         // Avoid extra work if everything was in the caches and
@@ -507,6 +569,7 @@ bool MythDB::GetSettings(QMap<QString,QString> &_key_value_pairs)
 
     keylist = keylist.left(keylist.length() - 1);
 
+    d->CountSettingsQuery();
     MSqlQuery query(MSqlQuery::InitCon());
     if (!query.exec(
             QString(
@@ -599,6 +662,9 @@ QString MythDB::GetSettingOnHost(const QString &_key, const QString &_host,
     QString value = defaultval;
     QString myKey = host + ' ' + key;
 
+    if (d->useSettingsCache && !d->settingsCacheComplete)
+        LoadSettingsCache();
+
     d->settingsCacheLock.lockForRead();
     if (d->useSettingsCache)
     {
@@ -617,9 +683,11 @@ QString MythDB::GetSettingOnHost(const QString &_key, const QString &_host,
         d->settingsCacheLock.unlock();
         return value;
     }
+    bool missing = d->useSettingsCache && d->settingsCacheComplete &&
+                   !d->staleSettings.contains(myKey);
     d->settingsCacheLock.unlock();
 
-    if (d->ignoreDatabase)
+    if (missing || d->ignoreDatabase)
         return value;
 
     MSqlQuery query(MSqlQuery::InitCon());
@@ -632,6 +700,8 @@ QString MythDB::GetSettingOnHost(const QString &_key, const QString &_host,
         return value;
     }
 
+    d->CountSettingsQuery();
+
     query.prepare(
         "SELECT data "
         "FROM settings "
@@ -845,6 +915,10 @@ void MythDB::ClearSettingsCache(const QString &_key)
         LOG(VB_DATABASE, LOG_INFO, "Clearing Settings Cache.");
         d->settingsCache.clear();
         d->settingsCache.reserve(settings_reserve);
+        d->settingsCacheComplete = false;
+        d->staleSettings.clear();
+        d->settingsCacheGeneration++;
+        d->settingsCacheLoading.fetchAndStoreOrdered(0);
 
         SettingsMap::const_iterator it = d->overriddenSettings.begin();
         for (; it != d->overriddenSettings.end(); ++it)
@@ -860,16 +934,130 @@ void MythDB::ClearSettingsCache(const QString &_key)
     {
         QString myKey = _key.toLower();
         clear(d->settingsCache, d->overriddenSettings, myKey);
+        d->staleSettings.insert(myKey);
 
         // To be safe always clear any local[ized] version too
         QString mkl = myKey.section(QChar(' '), 1);
         if (!mkl.isEmpty())
+        {
             clear(d->settingsCache, d->overriddenSettings, mkl);
+            d->staleSettings.insert(mkl);
+        }
     }
 
     d->settingsCacheLock.unlock();
 }
 
+/// Clears MythDBPrivate::settingsCacheLoading again unless the load worked
+class SettingsLoadGuard
+{
+  public:
+    explicit SettingsLoadGuard(QAtomicInt &loading) :
+        m_loading(loading), m_done(false) {}
+   ~SettingsLoadGuard()
+    {
+        if (!m_done)
+            m_loading.fetchAndStoreOrdered(0);
+    }
+
+    void Done(void) { m_done = true; }
+
+  private:
+    QAtomicInt &m_loading;
+    bool        m_done;
+};
+
+/** \brief Loads every setting into the settings cache with one query.
+ *
+ *   Afterwards a key that is missing from the cache is known to be
+ *   missing from the database too, so looking it up returns the default
+ *   without a query.  Keys cleared later are still read from the
+ *   database.  The settings are read without holding the cache lock and
+ *   merged in afterwards, unless the cache was cleared meanwhile; the
+ *   next lookup then loads it again.
+ */
+void MythDB::LoadSettingsCache(void)
+{
+    if (d->ignoreDatabase || !HaveValidDatabase())
+        return;
+
+    // Only one thread loads, the others use the database until it is done
+    if (!d->settingsCacheLoading.testAndSetOrdered(0, 1))
+        return;
+    // Any failure lets the next lookup try again
+    SettingsLoadGuard guard(d->settingsCacheLoading);
+
+    d->settingsCacheLock.lockForRead();
+    uint generation = d->settingsCacheGeneration;
+    d->settingsCacheLock.unlock();
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    if (!query.isConnected())
+        return;
+
+    d->CountSettingsQuery();
+    if (!query.exec("SELECT value, data, hostname FROM settings"))
+    {
+        if (!d->suppressDBMessages)
+            DBError("LoadSettingsCache", query);
+        return;
+    }
+
+    // Host specific values override the global ones for this host
+    SettingsMap settings, local;
+    settings.reserve(query.size());
+    while (query.next())
+    {
+        QString key   = query.value(0).toString().toLower();
+        QString value = query.value(1).toString();
+        value.squeeze();
+
+        if (query.value(2).isNull())
+        {
+            settings[key] = value;
+            continue;
+        }
+
+        QString host = query.value(2).toString().toLower();
+        if (host == d->m_localhostname)
+            local[key] = value;
+        settings[host + ' ' + key] = value;
+    }
+    for (SettingsMap::const_iterator it = local.begin();
+         it != local.end(); ++it)
+    {
+        settings[it.key()] = *it;
+    }
+
+    d->settingsCacheLock.lockForWrite();
+    if (d->useSettingsCache && generation == d->settingsCacheGeneration)
+    {
+        for (SettingsMap::const_iterator it = settings.begin();
+             it != settings.end(); ++it)
+        {
+            if (!d->settingsCache.contains(it.key()) &&
+                !d->staleSettings.contains(it.key()))
+            {
+                d->settingsCache[it.key()] = *it;
+            }
+        }
+        d->settingsCacheComplete = true;
+    }
+    d->settingsCacheLock.unlock();
+    guard.Done();
+
+    LOG(VB_DATABASE, LOG_INFO,
+        QString("Loaded %1 settings into the cache").arg(settings.size()));
+}
+
+/// \brief Returns the number of settings lookups that had to query the
+///        database, by the name of the thread that made them.
+QMap<QString,uint> MythDB::GetSettingsQueryCounts(void) const
+{
+    QMutexLocker locker(&d->settingsQueriesLock);
+    return d->settingsQueries;
+}
+
 void MythDB::ActivateSettingsCache(bool activate)
 {
     if (activate)
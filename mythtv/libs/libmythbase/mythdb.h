@@ -46,6 +46,7 @@ class MBASE_PUBLIC MythDB
     bool ClearSettingOnHost(const QString &key, const QString &host);
 
     bool GetSettings(QMap<QString,QString> &_key_value_pairs);
+    QMap<QString,uint> GetSettingsQueryCounts(void) const;
 
     QString GetSetting(     const QString &key, const QString &defaultval);
     int     GetNumSetting(  const QString &key, int            defaultval);
@@ -89,6 +90,8 @@ class MBASE_PUBLIC MythDB
    ~MythDB();
 
   private:
+    void LoadSettingsCache(void);
+
     MythDBPrivate *d;
 };
 
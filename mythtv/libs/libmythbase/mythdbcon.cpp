@@ -11,6 +11,7 @@
 #include <QSqlField>
 #include <QSqlRecord>
 #include <QElapsedTimer>
+#include <QtAlgorithms>
 
 // MythTV
 #include "compat.h"
@@ -30,6 +31,13 @@
 
 static const uint kPurgeTimeout = 60 * 60;
 
+/// Upper limits in ms of the query time histogram in MDBManager::GetStats()
+static const qint64 kQueryTimeLimits[] = { 1, 5, 20, 100, 500 };
+static const int kQueryTimeBuckets =
+    sizeof(kQueryTimeLimits) / sizeof(kQueryTimeLimits[0]) + 1;
+/// Number of distinct statements timed, later ones are counted together
+static const int kMaxQueryStats = 1000;
+
 bool TestDatabase(QString dbHostName,
                   QString dbUserName,
                   QString dbPassword,
@@ -265,6 +273,13 @@ MDBManager::MDBManager()
 
     m_schedCon = NULL;
     m_DDCon = NULL;
+
+    m_connOpened = 0;
+    m_connReused = 0;
+    m_connClosed = 0;
+    m_prepares = 0;
+    m_preparesReused = 0;
+    m_queryTimes.fill(0, kQueryTimeBuckets);
 }
 
 MDBManager::~MDBManager()
@@ -298,6 +313,7 @@ MSqlDatabase *MDBManager::popConnection(bool reuse)
         if (db != NULL)
         {
             m_inuse_count[QThread::currentThread()]++;
+            ++m_connReused;
             m_lock.unlock();
             return db;
         }
@@ -309,6 +325,7 @@ MSqlDatabase *MDBManager::popConnection(bool reuse)
     {
         db = new MSqlDatabase("DBManager" + QString::number(m_nextConnID++));
         ++m_connCount;
+        ++m_connOpened;
         LOG(VB_DATABASE, LOG_INFO,
                 QString("New DB connection, total: %1").arg(m_connCount));
     }
@@ -316,6 +333,7 @@ MSqlDatabase *MDBManager::popConnection(bool reuse)
     {
         db = list.back();
         list.pop_back();
+        ++m_connReused;
     }
 
 #if REUSE_CONNECTION
@@ -387,6 +405,7 @@ void MDBManager::PurgeIdleConnections(bool leaveOne)
         MSqlDatabase *entry = *it;
         it = list.erase(it);
         --m_connCount;
+        ++m_connClosed;
         purgedConnections++;
 
         // Qt's MySQL driver apparently keeps track of the number of
@@ -406,6 +425,7 @@ void MDBManager::PurgeIdleConnections(bool leaveOne)
             newDb = new MSqlDatabase("DBManager" +
                                      QString::number(m_nextConnID++));
             ++m_connCount;
+            ++m_connOpened;
             LOG(VB_GENERAL, LOG_INFO,
                     QString("New DB connection, total: %1").arg(m_connCount));
             newDb->m_lastDBKick = MythDate::current();
@@ -460,6 +480,7 @@ void MDBManager::CloseDatabases()
     m_lock.lock();
     DBList list = m_pool[QThread::currentThread()];
     m_pool[QThread::currentThread()].clear();
+    m_connClosed += list.size();
     m_lock.unlock();
 
     for (DBList::iterator it = list.begin(); it != list.end(); ++it)
@@ -489,6 +510,93 @@ void MDBManager::CloseDatabases()
     m_lock.unlock();
 }
 
+void MDBManager::AddPrepare(bool reused)
+{
+    QMutexLocker locker(&m_statsLock);
+    if (reused)
+        ++m_preparesReused;
+    else
+        ++m_prepares;
+}
+
+void MDBManager::AddQueryTime(const QString &query, qint64 msecs)
+{
+    int bucket = 0;
+    while (bucket < kQueryTimeBuckets - 1 && msecs >= kQueryTimeLimits[bucket])
+        ++bucket;
+
+    QMutexLocker locker(&m_statsLock);
+    ++m_queryTimes[bucket];
+
+    QHash<QString, QueryStats>::iterator it = m_queryStats.find(query);
+    if (it == m_queryStats.end() && m_queryStats.size() >= kMaxQueryStats)
+        it = m_queryStats.find("(other statements)");
+    if (it == m_queryStats.end())
+    {
+        QString key = (m_queryStats.size() >= kMaxQueryStats) ?
+            QString("(other statements)") : query;
+        it = m_queryStats.insert(key, QueryStats());
+    }
+    ++it->count;
+    it->total += msecs;
+    it->max = qMax(it->max, msecs);
+}
+
+static bool query_total_greater_than(const QPair<qint64, QString> &a,
+                                     const QPair<qint64, QString> &b)
+{
+    return a.first > b.first;
+}
+
+/** \brief Returns a readable summary of the connections made, the
+ *         statements prepared and how long queries took.
+ *
+ *   Connections stay with the thread that opened them, Qt doesn't allow
+ *   using them from another one.  A prepare is reused when an MSqlQuery
+ *   prepares the statement it has already prepared, only the bindings
+ *   are sent again then.
+ */
+QStringList MDBManager::GetStats(void)
+{
+    QStringList stats;
+
+    m_lock.lock();
+    stats << QString("Connections: %1 open, %2 opened, %3 reused, %4 closed")
+        .arg(m_connCount).arg(m_connOpened).arg(m_connReused)
+        .arg(m_connClosed);
+    m_lock.unlock();
+
+    QMutexLocker locker(&m_statsLock);
+    stats << QString("Prepares: %1 parsed, %2 reused")
+        .arg(m_prepares).arg(m_preparesReused);
+
+    QStringList times;
+    for (int i = 0; i < kQueryTimeBuckets - 1; ++i)
+    {
+        times << QString("<%1ms %2")
+            .arg(kQueryTimeLimits[i]).arg(m_queryTimes[i]);
+    }
+    times << QString(">=%1ms %2").arg(kQueryTimeLimits[kQueryTimeBuckets - 2])
+        .arg(m_queryTimes[kQueryTimeBuckets - 1]);
+    stats << "Query times: " + times.join(", ");
+
+    QList<QPair<qint64, QString> > byTotal;
+    QHash<QString, QueryStats>::const_iterator it = m_queryStats.begin();
+    for (; it != m_queryStats.end(); ++it)
+        byTotal.push_back(qMakePair(it->total, it.key()));
+    qSort(byTotal.begin(), byTotal.end(), query_total_greater_than);
+
+    for (int i = 0; i < byTotal.size() && i < 20; ++i)
+    {
+        const QueryStats &qs = m_queryStats[byTotal[i].second];
+        stats << QString("%1 ms total, %2 ms max, %3 runs: %4")
+            .arg(qs.total).arg(qs.max).arg(qs.count)
+            .arg(byTotal[i].second.simplified().left(200));
+    }
+
+    return stats;
+}
+
 
 // -----------------------------------------------------------------------
 
@@ -506,6 +614,7 @@ MSqlQuery::MSqlQuery(const MSqlQueryInfo &qi)
     m_isConnected = false;
     m_db = qi.db;
     m_returnConnection = qi.returnConnection;
+    m_prepared = false;
 
     m_isConnected = m_db && m_db->isOpen();
 
@@ -698,6 +807,8 @@ bool MSqlQuery::exec()
         }
     }
 
+    GetMythDB()->GetDBManager()->AddQueryTime(m_last_prepared_query, elapsed);
+
     return result;
 }
 
@@ -717,6 +828,12 @@ bool MSqlQuery::exec(const QString &query)
         return false;
     }
 
+    // This replaces any statement prepared before
+    m_prepared = false;
+
+    QElapsedTimer timer;
+    timer.start();
+
     bool result = QSqlQuery::exec(query);
 
     // if the query failed with "MySQL server has gone away"
@@ -725,6 +842,8 @@ bool MSqlQuery::exec(const QString &query)
     if (!result && QSqlQuery::lastError().number() == 2006 && Reconnect())
         result = QSqlQuery::exec(query);
 
+    GetMythDB()->GetDBManager()->AddQueryTime(query, timer.elapsed());
+
     LOG(VB_DATABASE, LOG_INFO,
             QString("MSqlQuery::exec(%1) %2%3")
                     .arg(m_db->MSqlDatabase::GetConnectionName()).arg(query)
@@ -803,6 +922,15 @@ bool MSqlQuery::prepare(const QString& query)
         return false;
     }
 
+    // Preparing the same statement again, as loops tend to do, would only
+    // have the server parse it again.  The new bindings replace the old.
+    if (m_prepared && query == m_last_prepared_query && m_db->isOpen())
+    {
+        GetMythDB()->GetDBManager()->AddPrepare(true);
+        return true;
+    }
+
+    m_prepared = false;
     m_last_prepared_query = query;
 
 #ifdef DEBUG_QT4_PORT
@@ -846,6 +974,9 @@ bool MSqlQuery::prepare(const QString& query)
     if (!ok && QSqlQuery::lastError().number() == 2006 && Reconnect())
         ok = true;
 
+    m_prepared = ok;
+    GetMythDB()->GetDBManager()->AddPrepare(false);
+
     if (!ok && !(GetMythDB()->SuppressDBMessages()))
     {
         LOG(VB_GENERAL, LOG_ERR,
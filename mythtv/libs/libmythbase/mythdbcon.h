@@ -10,6 +10,9 @@
 #include <QDateTime>
 #include <QMutex>
 #include <QList>
+#include <QHash>
+#include <QVector>
+#include <QStringList>
 
 #include "mythbaseexp.h"
 #include "mythdbparams.h"
@@ -60,6 +63,8 @@ class MBASE_PUBLIC MDBManager
     void CloseDatabases(void);
     void PurgeIdleConnections(bool leaveOne = false);
 
+    QStringList GetStats(void);
+
   protected:
     MSqlDatabase *popConnection(bool reuse);
     void pushConnection(MSqlDatabase *db);
@@ -67,6 +72,9 @@ class MBASE_PUBLIC MDBManager
     MSqlDatabase *getSchedCon(void);
     MSqlDatabase *getDDCon(void);
 
+    void AddPrepare(bool reused);
+    void AddQueryTime(const QString &query, qint64 msecs);
+
   private:
     MSqlDatabase *getStaticCon(MSqlDatabase **dbcon, QString name);
 
@@ -84,6 +92,24 @@ class MBASE_PUBLIC MDBManager
     MSqlDatabase *m_schedCon;
     MSqlDatabase *m_DDCon;
     QHash<QThread*, DBList> m_static_pool;
+
+    // Counters for GetStats()
+    uint m_connOpened;  // protected by m_lock
+    uint m_connReused;  // protected by m_lock
+    uint m_connClosed;  // protected by m_lock
+
+    struct QueryStats
+    {
+        QueryStats() : count(0), total(0), max(0) {}
+        uint   count;
+        qint64 total;
+        qint64 max;
+    };
+    QMutex m_statsLock;
+    uint m_prepares;        // protected by m_statsLock
+    uint m_preparesReused;  // protected by m_statsLock
+    QVector<uint> m_queryTimes; // protected by m_statsLock
+    QHash<QString, QueryStats> m_queryStats; // protected by m_statsLock
 };
 
 /// \brief MSqlDatabase Info, used by MSqlQuery. Do not use directly.
@@ -223,6 +249,7 @@ class MBASE_PUBLIC MSqlQuery : private QSqlQuery
     bool m_isConnected;
     bool m_returnConnection;
     QString m_last_prepared_query; // holds a copy of the last prepared query
+    bool m_prepared; // m_last_prepared_query is prepared and can be reused
 #ifdef DEBUG_QT4_PORT
     QRegExp m_testbindings;
 #endif
@@ -1,5 +1,9 @@
 #include <QImageReader>
 #include <QApplication>
+#include <QWaitCondition>
+#include <QRunnable>
+#include <QMutex>
+#include <QSet>
 #include <QUrl>
 
 #include "mythcontext.h"
@@ -16,6 +20,11 @@
 #include "remoteutil.h"
 #include "mythlogging.h"
 #include "mythdate.h"
+#include "mthreadpool.h"
+#include "mythtimer.h"
+
+/// Most directories scanned, or files hashed, at the same time
+static const int kMaxScanThreads = 8;
 
 QEvent::Type VideoScanChanges::kEventType =
     (QEvent::Type) QEvent::registerEventType();
@@ -68,6 +77,94 @@ namespace
         image_ext m_image_ext;
         DirListType &m_video_files;
     };
+
+    /// Lets the scanner thread report the progress of its pool tasks
+    class ScanProgress
+    {
+      public:
+        ScanProgress() : m_done(0) {}
+
+        void Done(void)
+        {
+            QMutexLocker locker(&m_lock);
+            m_done++;
+            m_wait.wakeAll();
+        }
+
+        /// Waits until more than \p last tasks are done, returns how many
+        uint Wait(uint last)
+        {
+            QMutexLocker locker(&m_lock);
+            if (m_done == last)
+                m_wait.wait(&m_lock);
+            return m_done;
+        }
+
+      private:
+        QMutex         m_lock;
+        QWaitCondition m_wait;
+        uint           m_done;
+    };
+
+    template <typename DirListType>
+    class DirScanTask : public QRunnable
+    {
+      public:
+        DirScanTask(const QString &directory,
+                    const QStringList &image_extensions,
+                    const FileAssociations::ext_ignore_list &ext_list,
+                    bool list_unknown, ScanProgress &progress) :
+            m_directory(directory), m_image_extensions(image_extensions),
+            m_ext_list(ext_list), m_list_unknown(list_unknown),
+            m_progress(progress), m_ok(false)
+        {
+            setAutoDelete(false);
+        }
+
+        void run(void)
+        {
+            LOG(VB_GENERAL, LOG_INFO, QString("buildFileList directory = %1")
+                                         .arg(m_directory));
+            dirhandler<DirListType> dh(m_files, m_image_extensions);
+            m_ok = ScanVideoDirectory(m_directory, &dh, m_ext_list,
+                                      m_list_unknown);
+            m_progress.Done();
+        }
+
+        const QString &GetDirectory(void) const { return m_directory; }
+        const DirListType &GetFiles(void) const { return m_files; }
+        bool IsOK(void) const { return m_ok; }
+
+      private:
+        QString                            m_directory;
+        QStringList                        m_image_extensions;
+        FileAssociations::ext_ignore_list  m_ext_list;
+        bool                               m_list_unknown;
+        ScanProgress                      &m_progress;
+        DirListType                        m_files;
+        bool                               m_ok;
+    };
+
+    class FileHashTask : public QRunnable
+    {
+      public:
+        FileHashTask(const QString &filename, const QString &host,
+                     QString &hash, ScanProgress &progress) :
+            m_filename(filename), m_host(host), m_hash(hash),
+            m_progress(progress) {}
+
+        void run(void)
+        {
+            m_hash = VideoMetadata::VideoFileHash(m_filename, m_host);
+            m_progress.Done();
+        }
+
+      private:
+        QString       m_filename;
+        QString       m_host;
+        QString      &m_hash;
+        ScanProgress &m_progress;
+    };
 }
 
 class VideoMetadataListManager;
@@ -163,37 +260,24 @@ void VideoScannerThread::run()
 
     LOG(VB_GENERAL, LOG_INFO, QString("Beginning Video Scan."));
 
-    uint counter = 0;
+    MythTimer timer(MythTimer::kStartRunning);
     FileCheckList fs_files;
+    buildFileList(imageExtensions, fs_files);
 
-    if (m_HasGUI)
-        SendProgressEvent(counter, (uint)m_directories.size(),
-                          tr("Searching for video files"));
-    for (QStringList::const_iterator iter = m_directories.begin();
-         iter != m_directories.end(); ++iter)
-    {
-        if (!buildFileList(*iter, imageExtensions, fs_files))
-        {
-            if (iter->startsWith("myth://"))
-            {
-                QUrl sgurl = *iter;
-                QString host = sgurl.host().toLower();
-                QString path = sgurl.path();
-
-                m_liveSGHosts.removeAll(host);
-
-                LOG(VB_GENERAL, LOG_ERR,
-                    QString("Failed to scan :%1:").arg(*iter));
-            }
-        }
-        if (m_HasGUI)
-            SendProgressEvent(++counter);
-    }
+    LOG(VB_GENERAL, LOG_INFO,
+        QString("Found %1 video files in %2 directories in %3 ms")
+            .arg((uint)fs_files.size()).arg(m_directories.size())
+            .arg(timer.restart()));
 
     PurgeList db_remove;
     verifyFiles(fs_files, db_remove);
+    hashNewFiles(fs_files);
     m_DBDataChanged = updateDB(fs_files, db_remove);
 
+    LOG(VB_GENERAL, LOG_INFO,
+        QString("Video Scan updated the database in %1 ms")
+            .arg(timer.elapsed()));
+
     if (m_DBDataChanged)
     {
         QCoreApplication::postEvent(m_parent,
@@ -303,6 +387,16 @@ bool VideoScannerThread::updateDB(const FileCheckList &add, const PurgeList &rem
         SendProgressEvent(counter, (uint)(add.size() + remove.size()),
                           tr("Updating video database"));
 
+    // Hashes of the videos in the database, so only the files that are
+    // likely to have moved need a query
+    QSet<QString> known_hashes;
+    for (VideoMetadataListManager::metadata_list::const_iterator p =
+         m_dbmetadata->getList().begin();
+         p != m_dbmetadata->getList().end(); ++p)
+    {
+        known_hashes.insert((*p)->GetHash());
+    }
+
     for (FileCheckList::const_iterator p = add.begin(); p != add.end(); ++p)
     {
         // add files not already in the DB
@@ -311,8 +405,9 @@ bool VideoScannerThread::updateDB(const FileCheckList &add, const PurgeList &rem
             int id = -1;
 
             // Are we sure this needs adding?  Let's check our Hash list.
-            QString hash = VideoMetadata::VideoFileHash(p->first, p->second.host);
-            if (hash != "NULL" && !hash.isEmpty())
+            const QString &hash = p->second.hash;
+            if (hash != "NULL" && !hash.isEmpty() &&
+                known_hashes.contains(hash))
             {
                 id = VideoMetadata::UpdateHashedDBRecord(hash, p->first, p->second.host);
                 if (id != -1)
@@ -355,6 +450,7 @@ bool VideoScannerThread::updateDB(const FileCheckList &add, const PurgeList &rem
                 newFile.SetHost(p->second.host);
                 newFile.SaveToDatabase();
                 m_addList << newFile.GetID();
+                known_hashes.insert(hash);
             }
             ret += 1;
         }
@@ -379,8 +475,13 @@ bool VideoScannerThread::updateDB(const FileCheckList &add, const PurgeList &rem
     return ret;
 }
 
-bool VideoScannerThread::buildFileList(const QString &directory,
-                                       const QStringList &imageExtensions,
+/** \brief Scans m_directories for video files.
+ *
+ *   The directories are scanned in parallel, each into its own list, which
+ *   are then merged in the order of m_directories.  So as before a file
+ *   found in more than one directory gets the host of the last one.
+ */
+void VideoScannerThread::buildFileList(const QStringList &imageExtensions,
                                        FileCheckList &filelist)
 {
     // TODO: FileCheckList is a std::map, keyed off the filename. In the event
@@ -389,13 +490,98 @@ bool VideoScannerThread::buildFileList(const QString &directory,
     // the backend with the content stored in a storage group determined to be
     // local.
 
-    LOG(VB_GENERAL,LOG_INFO, QString("buildFileList directory = %1")
-                                 .arg(directory));
+    typedef DirScanTask<FileCheckList> ScanTask;
+
     FileAssociations::ext_ignore_list ext_list;
     FileAssociations::getFileAssociation().getExtensionIgnoreList(ext_list);
 
-    dirhandler<FileCheckList> dh(filelist, imageExtensions);
-    return ScanVideoDirectory(directory, &dh, ext_list, m_ListUnknown);
+    uint total = m_directories.size();
+    if (m_HasGUI)
+        SendProgressEvent(0, total, tr("Searching for video files"));
+
+    ScanProgress progress;
+    MThreadPool pool("VideoScanDirs");
+    pool.setMaxThreadCount(qMax(1, qMin((int)total, kMaxScanThreads)));
+
+    std::vector<ScanTask *> tasks;
+    for (QStringList::const_iterator iter = m_directories.begin();
+         iter != m_directories.end(); ++iter)
+    {
+        tasks.push_back(new ScanTask(*iter, imageExtensions, ext_list,
+                                     m_ListUnknown, progress));
+        pool.start(tasks.back(), "VideoScanDir");
+    }
+
+    for (uint done = 0; m_HasGUI && done < total;)
+    {
+        done = progress.Wait(done);
+        SendProgressEvent(done);
+    }
+    pool.waitForDone();
+
+    for (uint i = 0; i < tasks.size(); i++)
+    {
+        const QString &directory = tasks[i]->GetDirectory();
+        if (!tasks[i]->IsOK() && directory.startsWith("myth://"))
+        {
+            QUrl sgurl = directory;
+            m_liveSGHosts.removeAll(sgurl.host().toLower());
+
+            LOG(VB_GENERAL, LOG_ERR,
+                QString("Failed to scan :%1:").arg(directory));
+        }
+
+        const FileCheckList &files = tasks[i]->GetFiles();
+        for (FileCheckList::const_iterator p = files.begin();
+             p != files.end(); ++p)
+        {
+            filelist[p->first] = p->second;
+        }
+        delete tasks[i];
+    }
+}
+
+/** \brief Computes the hash of each file not in the database yet.
+ *
+ *   Several files are hashed at the same time, which mostly helps with
+ *   directories mounted from a NAS where every hash waits on the network.
+ */
+void VideoScannerThread::hashNewFiles(FileCheckList &files)
+{
+    uint total = 0;
+    for (FileCheckList::const_iterator p = files.begin();
+         p != files.end(); ++p)
+    {
+        if (!p->second.check)
+            total++;
+    }
+
+    if (!total)
+        return;
+
+    if (m_HasGUI)
+        SendProgressEvent(0, total, tr("Checking new video files"));
+
+    ScanProgress progress;
+    MThreadPool pool("VideoScanHash");
+    pool.setMaxThreadCount(qMin((int)total, kMaxScanThreads));
+
+    for (FileCheckList::iterator p = files.begin(); p != files.end(); ++p)
+    {
+        if (!p->second.check)
+        {
+            pool.start(new FileHashTask(p->first, p->second.host,
+                                        p->second.hash, progress),
+                       "VideoScanHash");
+        }
+    }
+
+    for (uint done = 0; m_HasGUI && done < total;)
+    {
+        done = progress.Wait(done);
+        SendProgressEvent(done);
+    }
+    pool.waitForDone();
 }
 
 void VideoScannerThread::SendProgressEvent(uint progress, uint total,
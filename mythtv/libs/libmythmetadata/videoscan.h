@@ -80,6 +80,7 @@ class META_PUBLIC VideoScannerThread : public MThread
     {
         bool check;
         QString host;
+        QString hash;   ///< set by hashNewFiles() when check is false
     };
 
     typedef std::vector<std::pair<unsigned int, QString> > PurgeList;
@@ -89,9 +90,9 @@ class META_PUBLIC VideoScannerThread : public MThread
 
     void verifyFiles(FileCheckList &files, PurgeList &remove);
     bool updateDB(const FileCheckList &add, const PurgeList &remove);
-    bool buildFileList(const QString &directory,
-                                        const QStringList &imageExtensions,
-                                        FileCheckList &filelist);
+    void buildFileList(const QStringList &imageExtensions,
+                       FileCheckList &filelist);
+    void hashNewFiles(FileCheckList &files);
 
     void SendProgressEvent(uint progress, uint total = 0,
             QString messsage = QString());
@@ -43,7 +43,7 @@
 class SERVICE_PUBLIC MythServices : public Service  //, public QScriptable ???
 {
     Q_OBJECT
-    Q_CLASSINFO( "version"    , "4.0" );
+    Q_CLASSINFO( "version"    , "4.1" );
     Q_CLASSINFO( "AddStorageGroupDir_Method",    "POST" )
     Q_CLASSINFO( "RemoveStorageGroupDir_Method", "POST" )
     Q_CLASSINFO( "PutSetting_Method",            "POST" )
@@ -79,6 +79,7 @@ class SERVICE_PUBLIC MythServices : public Service  //, public QScriptable ???
         virtual QString             GetHostName         ( ) = 0;
         virtual QStringList         GetHosts            ( ) = 0;
         virtual QStringList         GetKeys             ( ) = 0;
+        virtual QStringList         GetDatabaseStats    ( ) = 0;
 
         virtual DTC::StorageGroupDirList*  GetStorageGroupDirs ( const QString   &GroupName,
                                                                  const QString   &HostName ) = 0;
@@ -48,6 +48,15 @@
 #define SLOC QString("HLS(): ")
 #define SLOC_ERR QString("HLS() Error: ")
 
+/// The first few segments are kept short so a client can start playing
+/// without waiting for a full length segment to be transcoded.
+static const uint16_t kStartupSegments    = 3;
+static const uint16_t kStartupSegmentSize = 2;
+
+/// Minimum time between segment info and progress updates in the DB,
+/// status changes and the first segment are always written immediately.
+static const int      kStatusSaveInterval = 10000;
+
 /** \class HTTPLiveStreamThread
  *  \brief QRunnable class for running mythtranscode for HTTP Live Streams
  *
@@ -109,7 +118,8 @@ HTTPLiveStream::HTTPLiveStream(QString srcFile, uint16_t width, uint16_t height,
     m_created(MythDate::current()),
     m_lastModified(MythDate::current()),
     m_percentComplete(0),
-    m_status(kHLSStatusUndefined)
+    m_status(kHLSStatusUndefined),
+    m_statusDirty(false)
 {
     if ((m_width == 0) && (m_height == 0))
         m_width = 640;
@@ -154,7 +164,8 @@ HTTPLiveStream::HTTPLiveStream(QString srcFile, uint16_t width, uint16_t height,
 
 HTTPLiveStream::HTTPLiveStream(int streamid)
   : m_writing(false),
-    m_streamid(streamid)
+    m_streamid(streamid),
+    m_statusDirty(false)
 {
     LoadFromDB();
 }
@@ -163,6 +174,9 @@ HTTPLiveStream::~HTTPLiveStream()
 {
     if (m_writing)
     {
+        if (m_statusDirty)
+            SaveSegmentInfo();
+
         WritePlaylist(false, true);
         if (m_audioOnlyBitrate)
             WritePlaylist(true, true);
@@ -204,6 +218,15 @@ QString HTTPLiveStream::GetFilename(uint16_t segmentNumber, bool fileOnly,
     return filename.arg(1, 6, 10, QChar('0'));
 }
 
+uint16_t HTTPLiveStream::GetSegmentDuration(uint16_t segmentNumber) const
+{
+    if ((segmentNumber > 0) && (segmentNumber <= kStartupSegments) &&
+        (m_segmentSize > kStartupSegmentSize))
+        return kStartupSegmentSize;
+
+    return m_segmentSize;
+}
+
 QString HTTPLiveStream::GetCurrentFilename(bool audioOnly, bool encoded) const
 {
     return GetFilename(m_curSegment, false, audioOnly, encoded);
@@ -313,7 +336,16 @@ bool HTTPLiveStream::AddSegment(void)
     if (m_streamid == -1)
         return false;
 
-    MSqlQuery query(MSqlQuery::InitCon());
+    if (m_segmentTimer.isRunning())
+    {
+        // The segment just finished is now listed in the playlist,
+        // the first one being available is what a client waits for.
+        LOG(VB_RECORD, LOG_INFO, LOC +
+            QString("Segment %1 (%2 secs) ready after %3 ms")
+                .arg(m_curSegment).arg(GetSegmentDuration(m_curSegment))
+                .arg(m_segmentTimer.elapsed()));
+    }
+    m_segmentTimer.start();
 
     ++m_curSegment;
     ++m_segmentCount;
@@ -330,11 +362,14 @@ bool HTTPLiveStream::AddSegment(void)
             LOG(VB_GENERAL, LOG_ERR, LOC +
                 QString("Unable to delete %1.").arg(thisFile));
 
+        m_segmentLengths.remove(m_startSegment);
         ++m_startSegment;
         --m_segmentCount;
     }
 
-    SaveSegmentInfo();
+    // Clients find new segments through the playlist, the DB copy of the
+    // segment info only needs to be close, except for the first segment.
+    SaveSegmentInfo(m_curSegment <= 2);
     WritePlaylist(false);
 
     if (m_audioOnlyBitrate)
@@ -343,6 +378,17 @@ bool HTTPLiveStream::AddSegment(void)
     return true;
 }
 
+/** \brief Records how long the current segment really is.
+ *
+ *   Segments can only end on a keyframe, so one may run longer than
+ *   GetSegmentDuration().  The playlist announces the measured length.
+ */
+void HTTPLiveStream::SetCurrentSegmentLength(double seconds)
+{
+    if (m_curSegment && seconds > 0.0)
+        m_segmentLengths[m_curSegment] = seconds;
+}
+
 QString HTTPLiveStream::GetHTMLPageName(void) const
 {
     if (m_streamid == -1)
@@ -463,35 +509,43 @@ bool HTTPLiveStream::WritePlaylist(bool audioOnly, bool writeEndTag)
         return false;
     }
 
-    file.write(QString(
-        "#EXTM3U\n"
-        "#EXT-X-ALLOW-CACHE:YES\n"
-        "#EXT-X-TARGETDURATION:%1\n"
-        "#EXT-X-MEDIA-SEQUENCE:%2\n"
-        ).arg(m_segmentSize).arg(m_startSegment).toLatin1());
-
-    if (writeEndTag)
-        file.write("#EXT-X-ENDLIST\n");
-
     // Don't write out the current segment until the end
     unsigned int tmpSegCount = m_segmentCount - 1;
-    unsigned int i = 0;
     unsigned int segmentid = m_startSegment;
 
     if (writeEndTag)
         ++tmpSegCount;
 
-    while (i < tmpSegCount)
+    // Integer durations, rounded as the protocol version requires.  The
+    // target duration has to cover a segment that ran long.
+    QByteArray segments;
+    int targetDuration = m_segmentSize;
+    for (unsigned int i = 0; i < tmpSegCount; ++i)
     {
-        file.write(QString(
+        int duration = GetSegmentDuration(segmentid + i);
+        if (m_segmentLengths.contains(segmentid + i))
+            duration = qRound(m_segmentLengths[segmentid + i]);
+        targetDuration = qMax(targetDuration, duration);
+
+        segments += QString(
             "#EXTINF:%1,\n"
             "%2\n"
-            ).arg(m_segmentSize)
-             .arg(GetFilename(segmentid + i, true, audioOnly, true)).toLatin1());
-
-        ++i;
+            ).arg(duration)
+             .arg(GetFilename(segmentid + i, true, audioOnly, true)).toLatin1();
     }
 
+    file.write(QString(
+        "#EXTM3U\n"
+        "#EXT-X-ALLOW-CACHE:YES\n"
+        "#EXT-X-TARGETDURATION:%1\n"
+        "#EXT-X-MEDIA-SEQUENCE:%2\n"
+        ).arg(targetDuration).arg(m_startSegment).toLatin1());
+
+    if (writeEndTag)
+        file.write("#EXT-X-ENDLIST\n");
+
+    file.write(segments);
+
     file.close();
 
     if(rename(tmpFile.toLatin1().constData(),
@@ -505,24 +559,49 @@ bool HTTPLiveStream::WritePlaylist(bool audioOnly, bool writeEndTag)
     return true;
 }
 
-bool HTTPLiveStream::SaveSegmentInfo(void)
+/**
+ *  \brief Saves the segment info and percent complete to the DB
+ *
+ *   Unless \p force is set, the update is deferred while the last one
+ *   is less than kStatusSaveInterval old, so a stream with short segments
+ *   does not write to the DB several times a second.  Deferred updates
+ *   are written by the next call after the interval, by UpdateStatus()
+ *   or when the stream is closed.
+ */
+bool HTTPLiveStream::SaveSegmentInfo(bool force)
 {
     if (m_streamid == -1)
         return false;
 
+    m_statusDirty = true;
+
+    if (!force && m_statusTimer.isRunning() &&
+        (m_statusTimer.elapsed() < kStatusSaveInterval))
+        return true;
+
+    m_lastModified = MythDate::current();
+
     MSqlQuery query(MSqlQuery::InitCon());
     query.prepare(
         "UPDATE livestream "
         "SET startsegment = :START, currentsegment = :CURRENT, "
-        "    segmentcount = :COUNT "
+        "    segmentcount = :COUNT, percentcomplete = :PERCENT, "
+        "    lastmodified = :LASTMODIFIED "
         "WHERE id = :STREAMID; ");
     query.bindValue(":START", m_startSegment);
     query.bindValue(":CURRENT", m_curSegment);
     query.bindValue(":COUNT", m_segmentCount);
+    query.bindValue(":PERCENT", m_percentComplete);
+    query.bindValue(":LASTMODIFIED", m_lastModified);
     query.bindValue(":STREAMID", m_streamid);
 
+    m_statusTimer.start();
+
     if (query.exec())
+    {
+        m_statusDirty = false;
         return true;
+    }
 
     LOG(VB_GENERAL, LOG_ERR, LOC +
         QString("Unable to update segment info for streamid %1")
@@ -598,6 +677,9 @@ bool HTTPLiveStream::UpdateStatus(HTTPLiveStreamStatus status)
 
     m_status = status;
 
+    if (m_statusDirty)
+        SaveSegmentInfo();
+
     MSqlQuery query(MSqlQuery::InitCon());
     query.prepare(
         "UPDATE livestream "
@@ -644,24 +726,12 @@ bool HTTPLiveStream::UpdatePercentComplete(int percent)
     if (m_streamid == -1)
         return false;
 
-    MSqlQuery query(MSqlQuery::InitCon());
-    query.prepare(
-        "UPDATE livestream "
-        "SET percentcomplete = :PERCENT "
-        "WHERE id = :STREAMID; ");
-    query.bindValue(":PERCENT", percent);
-    query.bindValue(":STREAMID", m_streamid);
-
-    if (query.exec())
-    {
-        m_percentComplete = percent;
+    if ((percent == (int)m_percentComplete) && !m_statusDirty)
         return true;
-    }
 
-    LOG(VB_GENERAL, LOG_ERR, LOC +
-        QString("Unable to update percent complete for streamid %1")
-                .arg(m_streamid));
-    return false;
+    m_percentComplete = percent;
+
+    return SaveSegmentInfo(percent >= 100);
 }
 
 QString HTTPLiveStream::StatusToString(HTTPLiveStreamStatus status)
@@ -2,10 +2,12 @@
 #define HTTPLIVESTREAM_H
 
 #include <QString>
+#include <QMap>
 
 #include "datacontracts/liveStreamInfoList.h"
 
 #include "mythframe.h"
+#include "mythtimer.h"
 
 typedef enum {
     kHLSStatusUndefined    = -1,
@@ -44,6 +46,9 @@ class MTV_PUBLIC HTTPLiveStream
     QString  GetMetaPlaylistName(void) const;
     QString  GetPlaylistName(bool audioOnly = false) const;
     uint16_t GetSegmentSize(void) const { return m_segmentSize; }
+    uint16_t GetSegmentDuration(uint16_t segmentNumber) const;
+    uint16_t GetCurrentSegmentDuration(void) const
+        { return GetSegmentDuration(m_curSegment); }
     QString  GetFilename(uint16_t segmentNumber = 0, bool fileOnly = false,
                          bool audioOnly = false, bool encoded = false) const;
     QString  GetCurrentFilename(
@@ -55,12 +60,13 @@ class MTV_PUBLIC HTTPLiveStream
 
     int      AddStream(void);
     bool     AddSegment(void);
+    void     SetCurrentSegmentLength(double seconds);
 
     bool WriteHTML(void);
     bool WriteMetaPlaylist(void);
     bool WritePlaylist(bool audioOnly = false, bool writeEndTag = false);
 
-    bool SaveSegmentInfo(void);
+    bool SaveSegmentInfo(bool force = true);
 
     bool UpdateSizeInfo(uint16_t width, uint16_t height,
                         uint16_t srcwidth, uint16_t srcheight);
@@ -98,6 +104,8 @@ class MTV_PUBLIC HTTPLiveStream
     uint16_t    m_segmentCount;
     uint16_t    m_startSegment;
     uint16_t    m_curSegment;
+    /// measured length in seconds of the segments written, by number
+    QMap<uint16_t, double> m_segmentLengths;
     QString     m_httpPrefix;
     QString     m_httpPrefixRel;
     uint16_t    m_height;
@@ -115,6 +123,10 @@ class MTV_PUBLIC HTTPLiveStream
     QString     m_statusMessage;
 
     HTTPLiveStreamStatus m_status;
+
+    bool        m_statusDirty;   ///< segment info/percent not yet in the DB
+    MythTimer   m_statusTimer;   ///< time since segment info was saved
+    MythTimer   m_segmentTimer;  ///< time since the current segment started
 };
 
 #endif
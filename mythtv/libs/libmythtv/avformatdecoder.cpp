@@ -39,6 +39,7 @@ using namespace std;
 #include "DVD/dvdringbuffer.h"
 #include "Bluray/bdringbuffer.h"
 #include "mythavutil.h"
+#include "avprobecache.h"
 
 #include "lcddevice.h"
 
@@ -378,7 +379,8 @@ AvFormatDecoder::AvFormatDecoder(MythPlayer *parent,
       directrendering(false),
       no_dts_hack(false),           dorewind(false),
       gopset(false),                seen_gop(false),
-      seq_count(0),
+      seq_count(0),                 posmapSaveable(false),
+      probeCacheHit(false),         firstFrameLogged(false),
       prevgoppos(0),                gotVideoFrame(false),
       hasVideo(false),              needDummyVideoFrames(false),
       skipaudio(false),             allowedquit(false),
@@ -647,6 +649,10 @@ bool AvFormatDecoder::DoFastForward(long long desiredFrame, bool discardFrames)
     if (recordingHasPositionMap || livetv)
         return DecoderBase::DoFastForward(desiredFrame, discardFrames);
 
+    // Frames skipped by libavformat seeking leave holes in the
+    // position map we are building, it is not worth saving any more.
+    posmapSaveable = false;
+
     bool oldrawstate = getrawframes;
     getrawframes = false;
 
@@ -1045,6 +1051,10 @@ int AvFormatDecoder::OpenFile(RingBuffer *rbuffer, bool novideo,
 
     ringBuffer = rbuffer;
 
+    openTimer.start();
+    probeCacheHit = false;
+    firstFrameLogged = false;
+
     // Process frames immediately unless we're decoding
     // a DVD, in which case don't so that we don't show
     // anything whilst probing the data streams.
@@ -1207,15 +1217,38 @@ int AvFormatDecoder::OpenFile(RingBuffer *rbuffer, bool novideo,
 
     if (!scanned)
     {
-        int ret = FindStreamInfo();
-        if (ret < 0)
+        MythTimer probeTimer;
+        probeTimer.start();
+
+        // Finished files are identified well enough to reuse an earlier
+        // probe, anything still growing has to be probed every time.
+        bool cacheable = !livetv && !watchingrecording &&
+            !ringBuffer->IsDisc() && !ringBuffer->IsStreamed() &&
+            AVProbeCache::IsCacheable(fmt);
+        AVProbeCache probecache(fnames, ringBuffer->GetRealFileSize(),
+                                m_playbackinfo ?
+                                m_playbackinfo->GetRecordingID() : 0);
+
+        probeCacheHit = cacheable && probecache.Restore(ic);
+        if (!probeCacheHit)
         {
-            LOG(VB_GENERAL, LOG_ERR, LOC + "Could not find codec parameters. " +
-                    QString("file was \"%1\".").arg(filename));
-            avformat_close_input(&ic);
-            ic = NULL;
-            return -1;
+            int ret = FindStreamInfo();
+            if (ret < 0)
+            {
+                LOG(VB_GENERAL, LOG_ERR, LOC + "Could not find codec parameters. " +
+                        QString("file was \"%1\".").arg(filename));
+                avformat_close_input(&ic);
+                ic = NULL;
+                return -1;
+            }
+            if (cacheable)
+                probecache.Save(ic);
         }
+
+        LOG(VB_PLAYBACK, LOG_INFO, LOC +
+            QString("Stream info %1 after %2 ms")
+                .arg(probeCacheHit ? "restored from cache" : "probed")
+                .arg(probeTimer.elapsed()));
     }
 
     ic->streams_changed = HandleStreamChange;
@@ -1335,6 +1368,13 @@ int AvFormatDecoder::OpenFile(RingBuffer *rbuffer, bool novideo,
 
         dontSyncPositionMap = true;
         ic->build_index = 1;
+
+        // If the file is played through from the start, the keyframes
+        // found while parsing it are saved as its seek table, so the
+        // next playback can use index based seeking.
+        posmapSaveable = m_playbackinfo && !is_db_ignored &&
+            !watchingrecording && (keyframedist != 1) &&
+            !ringBuffer->IsDisc() && !ringBuffer->IsStreamed();
     }
     // we have a position map, disable libavformat's seek index
     else
@@ -3110,6 +3150,54 @@ void AvFormatDecoder::UpdateCaptionTracksFromStreams(
     UpdateATSCCaptionTracks();
 }
 
+/** \brief Saves the position map built by parsing the stream.
+ *
+ *   Files without a seek table are played using libavformat seeking,
+ *   which is slow and only keyframe accurate for some containers.  When
+ *   such a file has been read from the start to the end without seeking,
+ *   the keyframes and durations found on the way are complete, so they
+ *   are saved as if mythcommflag had built them.  The next time the file
+ *   is opened the position map is loaded from the database and seeks
+ *   use the index instead.
+ */
+void AvFormatDecoder::SavePositionMap(void)
+{
+    if (!posmapSaveable)
+        return;
+    posmapSaveable = false;
+
+    long long last_frame = 0;
+    {
+        QMutexLocker locker(&m_positionMapLock);
+        if (m_positionMap.size() < 2)
+            return;
+        last_frame = m_positionMap.back().index;
+    }
+
+    MythTimer t;
+    t.start();
+    uint64_t saved = SavePositionMapDelta(0, last_frame);
+    SaveTotalDuration();
+    SaveTotalFrames();
+
+    LOG(VB_PLAYBACK, LOG_INFO, LOC +
+        QString("Saved seek table with %1 keyframes up to frame %2 in %3 ms")
+            .arg(saved).arg(last_frame).arg(t.elapsed()));
+}
+
+/// \brief Returns true if ReadPacket() failed because the file ended.
+bool AvFormatDecoder::AtEndOfFile(int retval) const
+{
+    if (retval == AVERROR_EOF)
+        return true;
+
+    if (!ringBuffer)
+        return false;
+
+    long long size = ringBuffer->GetRealFileSize();
+    return size > 0 && ringBuffer->GetReadPosition() >= size;
+}
+
 void AvFormatDecoder::HandleGopStart(
     AVPacket *pkt, bool can_reliably_parse_keyframes)
 {
@@ -3163,6 +3251,9 @@ void AvFormatDecoder::HandleGopStart(
 
     lastKey = prevgoppos = framesRead - 1;
 
+    if (!can_reliably_parse_keyframes)
+        posmapSaveable = false;
+
     if (can_reliably_parse_keyframes &&
         !hasFullPositionMap && !livetv && !watchingrecording)
     {
@@ -3678,6 +3769,7 @@ bool AvFormatDecoder::ProcessVideoFrame(AVStream *stream, AVFrame *mpa_pic)
         }
         sws_scale(sws_ctx, mpa_pic->data, mpa_pic->linesize, 0, dim.height(),
                   tmppicture.data, tmppicture.linesize);
+        framecopy_count((uint64_t)dim.width() * dim.height() * 3 / 2);
 
         if (xf)
         {
@@ -3732,6 +3824,15 @@ bool AvFormatDecoder::ProcessVideoFrame(AVStream *stream, AVFrame *mpa_pic)
 
     decoded_video_frame = picframe;
     gotVideoFrame = 1;
+
+    if (!firstFrameLogged)
+    {
+        firstFrameLogged = true;
+        LOG(VB_PLAYBACK, LOG_INFO, LOC +
+            QString("First frame decoded %1 ms after open (%2 probe)")
+                .arg(openTimer.elapsed())
+                .arg(probeCacheHit ? "warm" : "cold"));
+    }
     framesPlayed++;
 
     lastvpts = temppts;
@@ -4881,6 +4982,10 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype)
                     continue;
 
                 SetEof(true);
+                // Only a complete read gives a complete seek table, not
+                // a read error or a remote file that went away
+                if (ic && AtEndOfFile(retval))
+                    SavePositionMap();
                 delete pkt;
                 errno = -retval;
                 LOG(VB_GENERAL, LOG_ERR, QString("decoding error") + ENO);
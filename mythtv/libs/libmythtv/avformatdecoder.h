@@ -19,6 +19,7 @@
 #include "H264Parser.h"
 #include "videodisplayprofile.h"
 #include "mythplayer.h"
+#include "mythtimer.h"
 
 extern "C" {
 #include "mythframe.h"
@@ -250,6 +251,9 @@ class AvFormatDecoder : public DecoderBase
     /// Update our position map, keyframe distance, and the like.
     /// Called for key frame packets.
     void HandleGopStart(AVPacket *pkt, bool can_reliably_parse_keyframes);
+    /// Save the position map built while playing as the seek table.
+    void SavePositionMap(void);
+    bool AtEndOfFile(int retval) const;
 
     bool GenerateDummyVideoFrames(void);
     bool HasVideo(const AVFormatContext *ic);
@@ -293,6 +297,15 @@ class AvFormatDecoder : public DecoderBase
     /// A flag to indicate that we've seen a GOP frame.  Used in junction with seq_count.
     bool seen_gop;
     int seq_count; ///< A counter used to determine if we need to force a call to HandleGopStart
+    /// The position map built while reading covers the file from its
+    /// start, so it can be saved as the seek table when EOF is reached.
+    bool posmapSaveable;
+
+    /// Time since OpenFile(), to log how long the first frame took.
+    MythTimer openTimer;
+    /// The stream info came from the AVProbeCache instead of a probe.
+    bool probeCacheHit;
+    bool firstFrameLogged;
 
     QList<AVPacket*> storedPackets;
 
@@ -0,0 +1,248 @@
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSettings>
+#include <QDir>
+
+#include "avprobecache.h"
+#include "mythlogging.h"
+#include "mythdirs.h"
+
+#define LOC QString("ProbeCache: ")
+
+/// Bump when the stored keys change, older entries are then ignored.
+static const int kProbeCacheVersion = 1;
+/// Number of files kept before the oldest ones are removed.
+static const int kProbeCacheMaxEntries = 500;
+
+static QString rational_to_string(const AVRational &r)
+{
+    return QString("%1/%2").arg(r.num).arg(r.den);
+}
+
+static AVRational string_to_rational(const QString &s)
+{
+    AVRational r;
+    r.num = s.section('/', 0, 0).toInt();
+    r.den = s.section('/', 1, 1).toInt();
+    return r;
+}
+
+static QString cache_dir(void)
+{
+    return GetConfDir() + "/cache/probecache/";
+}
+
+AVProbeCache::AVProbeCache(const QString &filename, long long filesize,
+                           uint recordingid) :
+    m_filename(filename)
+{
+    // Local files are also identified by their modification time,
+    // remote ones only by size since stat'ing them costs a round trip.
+    QString identity = QString("%1|%2|%3")
+        .arg(filename).arg(filesize).arg(recordingid);
+    QFileInfo info(filename);
+    if (info.exists())
+        identity += "|" + QString::number(info.lastModified().toTime_t());
+
+    QByteArray hash = QCryptographicHash::hash(
+        identity.toUtf8(), QCryptographicHash::Sha1).toHex();
+    m_cachefile = cache_dir() + QString(hash) + ".ini";
+}
+
+/** \fn AVProbeCache::IsCacheable(const AVInputFormat*)
+ *  \brief Only MPEG-TS is cached, its demuxer creates every stream from
+ *         the PMT while opening, so a changed layout is always noticed.
+ *         It is also the format that is slowest to probe.
+ */
+bool AVProbeCache::IsCacheable(const AVInputFormat *fmt)
+{
+    return fmt && QString(fmt->name).startsWith("mpegts");
+}
+
+bool AVProbeCache::Restore(AVFormatContext *ic) const
+{
+    if (!QFileInfo(m_cachefile).exists())
+        return false;
+
+    QSettings cache(m_cachefile, QSettings::IniFormat);
+    if (cache.value("version").toInt() != kProbeCacheVersion ||
+        cache.value("format").toString() != ic->iformat->name)
+    {
+        return false;
+    }
+
+    uint nb_streams = cache.value("streams").toUInt();
+    if (nb_streams != ic->nb_streams)
+    {
+        LOG(VB_PLAYBACK, LOG_INFO, LOC +
+            QString("%1 streams cached but %2 found, probing '%3'")
+                .arg(nb_streams).arg(ic->nb_streams).arg(m_filename));
+        return false;
+    }
+
+    // Check the layout before touching anything, so a mismatch leaves
+    // the context as the demuxer created it.
+    for (uint i = 0; i < ic->nb_streams; i++)
+    {
+        AVStream *st = ic->streams[i];
+        cache.beginGroup(QString("stream%1").arg(i));
+        bool same =
+            cache.value("id").toInt()         == st->id &&
+            cache.value("type").toInt()       == st->codec->codec_type &&
+            cache.value("codec").toInt()      == st->codec->codec_id &&
+            cache.value("time_base").toString() ==
+                rational_to_string(st->time_base);
+        cache.endGroup();
+
+        if (!same)
+        {
+            LOG(VB_PLAYBACK, LOG_INFO, LOC +
+                QString("Stream %1 differs from the cached one, probing '%2'")
+                    .arg(i).arg(m_filename));
+            return false;
+        }
+    }
+
+    for (uint i = 0; i < ic->nb_streams; i++)
+    {
+        AVStream       *st  = ic->streams[i];
+        AVCodecContext *enc = st->codec;
+        cache.beginGroup(QString("stream%1").arg(i));
+
+        st->start_time     = cache.value("start_time").toLongLong();
+        st->duration       = cache.value("duration").toLongLong();
+        st->r_frame_rate   = string_to_rational(
+            cache.value("r_frame_rate").toString());
+        st->avg_frame_rate = string_to_rational(
+            cache.value("avg_frame_rate").toString());
+        st->sample_aspect_ratio = string_to_rational(
+            cache.value("stream_sar").toString());
+        enc->bit_rate  = cache.value("bit_rate").toInt();
+        enc->profile   = cache.value("profile").toInt();
+        enc->level     = cache.value("level").toInt();
+        enc->time_base = string_to_rational(
+            cache.value("codec_time_base").toString());
+
+        if (enc->codec_type == AVMEDIA_TYPE_VIDEO)
+        {
+            enc->width          = cache.value("width").toInt();
+            enc->height         = cache.value("height").toInt();
+            enc->coded_width    = cache.value("coded_width").toInt();
+            enc->coded_height   = cache.value("coded_height").toInt();
+            enc->pix_fmt        =
+                (AVPixelFormat)cache.value("pix_fmt").toInt();
+            enc->has_b_frames   = cache.value("has_b_frames").toInt();
+            enc->ticks_per_frame = cache.value("ticks_per_frame").toInt();
+            enc->field_order    =
+                (AVFieldOrder)cache.value("field_order").toInt();
+            enc->sample_aspect_ratio = string_to_rational(
+                cache.value("sar").toString());
+        }
+        else if (enc->codec_type == AVMEDIA_TYPE_AUDIO)
+        {
+            enc->sample_rate    = cache.value("sample_rate").toInt();
+            enc->channels       = cache.value("channels").toInt();
+            enc->channel_layout = cache.value("channel_layout").toULongLong();
+            enc->sample_fmt     =
+                (AVSampleFormat)cache.value("sample_fmt").toInt();
+            enc->frame_size     = cache.value("frame_size").toInt();
+        }
+
+        cache.endGroup();
+    }
+
+    ic->start_time = cache.value("start_time").toLongLong();
+    ic->duration   = cache.value("duration").toLongLong();
+    ic->bit_rate   = cache.value("bit_rate").toInt();
+
+    return true;
+}
+
+void AVProbeCache::Save(const AVFormatContext *ic) const
+{
+    QString dirname = cache_dir();
+    QDir dir(dirname);
+    if (!dir.exists() && !dir.mkpath(dirname))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to create '%1'").arg(dirname));
+        return;
+    }
+
+    QSettings cache(m_cachefile, QSettings::IniFormat);
+    cache.clear();
+    cache.setValue("version",    kProbeCacheVersion);
+    cache.setValue("format",     ic->iformat->name);
+    cache.setValue("streams",    ic->nb_streams);
+    cache.setValue("start_time", (qlonglong)ic->start_time);
+    cache.setValue("duration",   (qlonglong)ic->duration);
+    cache.setValue("bit_rate",   ic->bit_rate);
+
+    for (uint i = 0; i < ic->nb_streams; i++)
+    {
+        const AVStream       *st  = ic->streams[i];
+        const AVCodecContext *enc = st->codec;
+        cache.beginGroup(QString("stream%1").arg(i));
+
+        cache.setValue("id",         st->id);
+        cache.setValue("type",       (int)enc->codec_type);
+        cache.setValue("codec",      (int)enc->codec_id);
+        cache.setValue("time_base",  rational_to_string(st->time_base));
+        cache.setValue("start_time", (qlonglong)st->start_time);
+        cache.setValue("duration",   (qlonglong)st->duration);
+        cache.setValue("r_frame_rate",   rational_to_string(st->r_frame_rate));
+        cache.setValue("avg_frame_rate",
+                       rational_to_string(st->avg_frame_rate));
+        cache.setValue("stream_sar",
+                       rational_to_string(st->sample_aspect_ratio));
+        cache.setValue("bit_rate",   enc->bit_rate);
+        cache.setValue("profile",    enc->profile);
+        cache.setValue("level",      enc->level);
+        cache.setValue("codec_time_base", rational_to_string(enc->time_base));
+
+        if (enc->codec_type == AVMEDIA_TYPE_VIDEO)
+        {
+            cache.setValue("width",           enc->width);
+            cache.setValue("height",          enc->height);
+            cache.setValue("coded_width",     enc->coded_width);
+            cache.setValue("coded_height",    enc->coded_height);
+            cache.setValue("pix_fmt",         (int)enc->pix_fmt);
+            cache.setValue("has_b_frames",    enc->has_b_frames);
+            cache.setValue("ticks_per_frame", enc->ticks_per_frame);
+            cache.setValue("field_order",     (int)enc->field_order);
+            cache.setValue("sar", rational_to_string(enc->sample_aspect_ratio));
+        }
+        else if (enc->codec_type == AVMEDIA_TYPE_AUDIO)
+        {
+            cache.setValue("sample_rate",    enc->sample_rate);
+            cache.setValue("channels",       enc->channels);
+            cache.setValue("channel_layout", (qulonglong)enc->channel_layout);
+            cache.setValue("sample_fmt",     (int)enc->sample_fmt);
+            cache.setValue("frame_size",     enc->frame_size);
+        }
+
+        cache.endGroup();
+    }
+
+    cache.sync();
+    if (cache.status() != QSettings::NoError)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to write '%1'").arg(m_cachefile));
+        return;
+    }
+
+    Prune(dirname);
+}
+
+/// Removes the least recently written entries once there are too many.
+void AVProbeCache::Prune(const QString &dirname)
+{
+    QDir dir(dirname, "*.ini", QDir::Time, QDir::Files);
+    QFileInfoList entries = dir.entryInfoList();
+    for (int i = kProbeCacheMaxEntries; i < entries.size(); i++)
+        QFile::remove(entries[i].absoluteFilePath());
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -0,0 +1,46 @@
+#ifndef AVPROBECACHE_H_
+#define AVPROBECACHE_H_
+
+#include <QString>
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+
+/** \class AVProbeCache
+ *  \brief Remembers what avformat_find_stream_info() found in a file.
+ *
+ *   Probing an MPEG-TS file reads several megabytes and decodes frames
+ *   of every stream, which is slow on remote storage and is repeated
+ *   for every preview, commflag, transcode and playback of the same
+ *   recording.  After a full probe the codec parameters, stream layout
+ *   and start times are saved under the configuration directory, keyed
+ *   by the file's identity.  A later open restores them into the freshly
+ *   opened context instead of probing, provided the demuxer found the
+ *   same streams again.
+ */
+class AVProbeCache
+{
+  public:
+    /// \param recordingid recording the file belongs to, 0 if none
+    AVProbeCache(const QString &filename, long long filesize,
+                 uint recordingid = 0);
+
+    /// Returns true if files of this format can be cached.
+    static bool IsCacheable(const AVInputFormat *fmt);
+
+    /// Returns true if the cached parameters were applied to \p ic,
+    /// false if the file has to be probed.
+    bool Restore(AVFormatContext *ic) const;
+    void Save(const AVFormatContext *ic) const;
+
+  private:
+    static void Prune(const QString &dirname);
+
+    QString m_filename;
+    QString m_cachefile;
+};
+
+#endif // AVPROBECACHE_H_
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
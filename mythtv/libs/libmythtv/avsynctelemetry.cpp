@@ -0,0 +1,118 @@
+#include <QTextStream>
+#include <QFile>
+
+#include "avsynctelemetry.h"
+#include "mythlogging.h"
+
+#define LOC QString("AVSyncTelemetry: ")
+
+/// Frames the decoder may be ahead of the display, see FrameReady().
+static const uint kReadySlots = 64;
+
+/// \brief Sets the number of samples kept, 0 turns recording off.
+void AVSyncTelemetry::Resize(uint size)
+{
+    QMutexLocker locker(&m_lock);
+    m_size      = size;
+    m_samples.fill(Sample(), size);
+    m_next      = 0;
+    m_count     = 0;
+    m_ready.fill(QPair<int64_t,int64_t>(-1, 0), size ? kReadySlots : 0);
+    m_readyNext = 0;
+}
+
+/** \fn AVSyncTelemetry::FrameReady(int64_t, int64_t)
+ *  \brief Called by the decoder thread when the frame with the given
+ *         timecode is put on the queue of frames ready for display.
+ */
+void AVSyncTelemetry::FrameReady(int64_t timecode, int64_t now)
+{
+    if (!m_size)
+        return;
+
+    QMutexLocker locker(&m_lock);
+    m_ready[m_readyNext] = QPair<int64_t,int64_t>(timecode, now);
+    m_readyNext = (m_readyNext + 1) % kReadySlots;
+}
+
+/** \fn AVSyncTelemetry::AddSample(Sample&)
+ *  \brief Records a frame that has been shown or dropped, filling in
+ *         when it was decoded if FrameReady() saw it.
+ */
+void AVSyncTelemetry::AddSample(Sample &sample)
+{
+    if (!m_size)
+        return;
+
+    QMutexLocker locker(&m_lock);
+    for (uint i = 0; i < kReadySlots && !sample.ready; i++)
+    {
+        if (m_ready[i].first == sample.timecode)
+        {
+            sample.ready = m_ready[i].second;
+            m_ready[i].first = -1;
+        }
+    }
+
+    m_samples[m_next] = sample;
+    m_next = (m_next + 1) % m_size;
+    if (m_count < m_size)
+        m_count++;
+}
+
+void AVSyncTelemetry::Clear(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_next  = 0;
+    m_count = 0;
+}
+
+QVector<AVSyncTelemetry::Sample> AVSyncTelemetry::GetSamples(void) const
+{
+    QMutexLocker locker(&m_lock);
+    QVector<Sample> samples;
+    samples.reserve(m_count);
+    uint first = (m_next + m_size - m_count) % qMax(m_size, 1U);
+    for (uint i = 0; i < m_count; i++)
+        samples.push_back(m_samples[(first + i) % m_size]);
+    return samples;
+}
+
+/** \fn AVSyncTelemetry::WriteCSV(const QString&) const
+ *  \brief Writes the recorded samples to filename, one line per frame.
+ *
+ *   Lateness is the time between the deadline and the actual Show(),
+ *   negative when the frame was shown early.
+ */
+bool AVSyncTelemetry::WriteCSV(const QString &filename) const
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to open '%1' for writing").arg(filename));
+        return false;
+    }
+
+    QVector<Sample> samples = GetSamples();
+    QTextStream out(&file);
+    out << "frame,timecode_ms,audio_ms,ready_us,target_us,presented_us,"
+           "lateness_us,avsync_delay_us,adjustment_us,dropped\n";
+    for (int i = 0; i < samples.size(); i++)
+    {
+        const Sample &s = samples[i];
+        out << s.frame << ',' << s.timecode << ',' << s.audiotime << ','
+            << s.ready << ',' << s.target << ',' << s.presented << ','
+            << (s.dropped ? 0 : s.presented - s.target) << ','
+            << s.avsync_delay << ',' << s.adjustment << ','
+            << (s.dropped ? 1 : 0) << '\n';
+    }
+    out.flush();
+
+    LOG(VB_PLAYBACK, LOG_INFO, LOC +
+        QString("Wrote %1 frames to '%2'").arg(samples.size()).arg(filename));
+
+    return file.error() == QFile::NoError;
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
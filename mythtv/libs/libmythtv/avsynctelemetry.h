@@ -0,0 +1,69 @@
+#ifndef AVSYNCTELEMETRY_H
+#define AVSYNCTELEMETRY_H
+
+#include <stdint.h>
+
+#include <QVector>
+#include <QString>
+#include <QMutex>
+#include <QPair>
+
+#include "mythtvexp.h"
+
+/** \class AVSyncTelemetry
+ *  \brief Records when every frame was decoded, due and shown.
+ *
+ *   MythPlayer adds one sample per frame that passes through AVSync().
+ *   The most recent samples are kept in a ring buffer and can be written
+ *   out as CSV, which makes judder much easier to see than the averages
+ *   printed by Jitterometer.  Recording is off unless a size is given,
+ *   MythPlayer enables it when the MYTHTV_AVSYNC_CSV environment variable
+ *   names the file to write when playback ends.
+ *
+ *   All times are in microseconds on the VideoSync::GetTime() clock.
+ */
+class MTV_PUBLIC AVSyncTelemetry
+{
+  public:
+    struct Sample
+    {
+        Sample() :
+            frame(0), timecode(0), audiotime(0), ready(0), target(0),
+            presented(0), avsync_delay(0), adjustment(0), dropped(false) {}
+
+        long long frame;
+        int64_t   timecode;     ///< video timecode in ms
+        int64_t   audiotime;    ///< audio clock in ms when the frame was shown
+        int64_t   ready;        ///< decoder released the frame, 0 if unknown
+        int64_t   target;       ///< deadline the frame was scheduled for
+        int64_t   presented;    ///< VideoOutput::Show() returned
+        int       avsync_delay; ///< measured video - audio offset in usecs
+        int       adjustment;   ///< correction applied to the next frame
+        bool      dropped;
+    };
+
+    explicit AVSyncTelemetry(uint size = 0) { Resize(size); }
+
+    void Resize(uint size);
+    bool IsEnabled(void) const { return m_size > 0; }
+
+    void FrameReady(int64_t timecode, int64_t now);
+    void AddSample(Sample &sample);
+    void Clear(void);
+
+    /// \brief Returns the samples recorded, oldest first.
+    QVector<Sample> GetSamples(void) const;
+    bool WriteCSV(const QString &filename) const;
+
+  private:
+    mutable QMutex   m_lock;
+    uint             m_size;
+    QVector<Sample>  m_samples;
+    uint             m_next;  ///< ring position of the next sample
+    uint             m_count; ///< samples recorded, up to m_size
+    /// (timecode, ready time) of frames the decoder released recently
+    QVector<QPair<int64_t,int64_t> > m_ready;
+    uint             m_readyNext;
+};
+
+#endif // AVSYNCTELEMETRY_H
@@ -16,8 +16,9 @@ typedef map<QString,void*>       library_map_t;
 typedef map<QString,FilterInfo*> filter_map_t;
 
 #include "videoouttypes.h"
+#include "mythtvexp.h"
 
-class FilterChain
+class MTV_PUBLIC FilterChain
 {
   public:
     FilterChain() { }
@@ -31,7 +32,7 @@ class FilterChain
     vector<VideoFilter*> filters;
 };
 
-class FilterManager
+class MTV_PUBLIC FilterManager
 {
   public:
     FilterManager();
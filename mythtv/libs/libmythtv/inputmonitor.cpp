@@ -0,0 +1,229 @@
+#include <QRunnable>
+#include <QTimer>
+
+#include "inputmonitor.h"
+#include "mythlogging.h"
+#include "mythtimer.h"
+#include "mythdate.h"
+
+#define LOC QString("InputMonitor: ")
+
+/** \brief Initializes the inputs of one capture device.
+ *
+ *   Inputs sharing a device are opened one after the other, since the
+ *   first one opened becomes the master the others attach to.
+ */
+class InputInitTask : public QRunnable
+{
+  public:
+    InputInitTask(InputMonitor *monitor, InputInitializer *inputs,
+                  const vector<uint> &cardids, bool create) :
+        m_monitor(monitor), m_inputs(inputs), m_cardids(cardids),
+        m_create(create) {}
+
+    virtual void run(void)
+    {
+        for (uint i = 0; i < m_cardids.size(); i++)
+        {
+            MythTimer timer(MythTimer::kStartRunning);
+
+            bool ok = m_inputs->InitInput(m_cardids[i], m_create);
+
+            LOG(VB_GENERAL, ok ? LOG_INFO : LOG_ERR, LOC +
+                QString("Card %1 %2 in %3 ms").arg(m_cardids[i])
+                    .arg(ok ? "initialized" : "failed to initialize")
+                    .arg(timer.elapsed()));
+
+            m_monitor->InitDone(m_cardids[i], ok);
+        }
+    }
+
+  private:
+    InputMonitor     *m_monitor;
+    InputInitializer *m_inputs;
+    vector<uint>      m_cardids;
+    bool              m_create;
+};
+
+/** \brief Creates a monitor for the inputs of \p inputs.
+ *
+ *   Monitored cards are checked every \p checkInterval ms, and those that
+ *   failed are tried again after \p retryInterval ms.  With a
+ *   checkInterval of 0 there is no timer, the owner calls CheckInputs().
+ */
+InputMonitor::InputMonitor(InputInitializer *inputs, uint checkInterval,
+                           uint retryInterval) :
+    m_inputs(inputs), m_checkInterval(checkInterval),
+    m_retryInterval(retryInterval), m_pool("InputInit"),
+    m_timer(new QTimer(this))
+{
+    connect(m_timer, SIGNAL(timeout()), SLOT(CheckInputs()));
+}
+
+/** \brief Waits for the init tasks still running.
+ *
+ *  An input's initialization can't be interrupted, so this blocks for as
+ *  long as the slowest device takes to give up.
+ */
+InputMonitor::~InputMonitor()
+{
+    m_timer->stop();
+    m_pool.waitForDone();
+}
+
+/** \brief Initializes the given cards in parallel.
+ *
+ *   The recorders must have been created already.  Returns once all of
+ *   them are done or after \p timeout ms, 0 waits for all of them.  Use
+ *   IsReady() and HasFailed() to find out how each card fared.
+ */
+void InputMonitor::InitInputs(const vector<uint> &cardids, uint timeout)
+{
+    StartInit(cardids, false);
+
+    MythTimer timer(MythTimer::kStartRunning);
+    QMutexLocker locker(&m_lock);
+    for (uint i = 0; i < cardids.size(); i++)
+    {
+        while (m_state[cardids[i]] == kInitializing)
+        {
+            if (!timeout)
+            {
+                m_wait.wait(&m_lock);
+                continue;
+            }
+
+            int left = (int)timeout - timer.elapsed();
+            if (left <= 0 || !m_wait.wait(&m_lock, left))
+            {
+                LOG(VB_GENERAL, LOG_WARNING, LOC +
+                    QString("Card %1 is still initializing after %2 ms, "
+                            "continuing without it").arg(cardids[i])
+                        .arg(timer.elapsed()));
+                break;
+            }
+        }
+    }
+}
+
+void InputMonitor::StartInit(const vector<uint> &cardids, bool create)
+{
+    QMap<QString, vector<uint> > devices;
+    for (uint i = 0; i < cardids.size(); i++)
+        devices[m_inputs->GetDevice(cardids[i])].push_back(cardids[i]);
+
+    m_lock.lock();
+    for (uint i = 0; i < cardids.size(); i++)
+        m_state[cardids[i]] = kInitializing;
+    m_lock.unlock();
+
+    // One thread per device, several of them may hang until they time out
+    m_pool.setMaxThreadCount(qMax(m_pool.maxThreadCount(), devices.size()));
+
+    QMap<QString, vector<uint> >::const_iterator it = devices.begin();
+    for (; it != devices.end(); ++it)
+        m_pool.start(new InputInitTask(this, m_inputs, *it, create),
+                     "InputInit");
+}
+
+bool InputMonitor::IsReady(uint cardid)
+{
+    QMutexLocker locker(&m_lock);
+    return m_state.value(cardid, kFailed) == kReady;
+}
+
+bool InputMonitor::HasFailed(uint cardid)
+{
+    QMutexLocker locker(&m_lock);
+    return m_state.value(cardid, kFailed) == kFailed;
+}
+
+/** \brief Adds the card with AddInput() as soon as it initializes,
+ *         retrying when it fails.
+ */
+void InputMonitor::Monitor(uint cardid)
+{
+    QMutexLocker locker(&m_lock);
+    m_monitored[cardid] = true;
+    m_nextRetry[cardid] = MythDate::current().addMSecs(m_retryInterval);
+
+    if (m_checkInterval && !m_timer->isActive())
+        m_timer->start(m_checkInterval);
+}
+
+void InputMonitor::InitDone(uint cardid, bool ok)
+{
+    QMutexLocker locker(&m_lock);
+    QDateTime now = MythDate::current();
+    m_state[cardid] = ok ? kReady : kFailed;
+    m_nextRetry[cardid] = ok ? now : now.addMSecs(m_retryInterval);
+    m_wait.wakeAll();
+}
+
+/** \brief Adds the monitored cards that became ready and starts another
+ *         try for those whose retry is due.
+ *
+ *   A card AddInput() refuses stays ready and is offered again after the
+ *   retry interval, its recorder is initialized already.
+ */
+void InputMonitor::CheckInputs(void)
+{
+    QDateTime now = MythDate::current();
+    vector<uint> ready, retry;
+
+    m_lock.lock();
+    QMap<uint, bool>::iterator it = m_monitored.begin();
+    for (; it != m_monitored.end(); ++it)
+    {
+        uint cardid = it.key();
+        InputState state = m_state.value(cardid, kFailed);
+
+        if (now < m_nextRetry[cardid])
+            continue;
+        if (state == kReady)
+            ready.push_back(cardid);
+        else if (state == kFailed)
+            retry.push_back(cardid);
+    }
+    m_lock.unlock();
+
+    // Outside the lock, AddInput() may take locks of its own
+    vector<uint> added, refused;
+    for (uint i = 0; i < ready.size(); i++)
+    {
+        if (m_inputs->AddInput(ready[i]))
+        {
+            added.push_back(ready[i]);
+            LOG(VB_GENERAL, LOG_NOTICE, LOC +
+                QString("Card %1 is available now").arg(ready[i]));
+        }
+        else
+        {
+            refused.push_back(ready[i]);
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Card %1 initialized but could not be added, "
+                        "trying again in %2 s")
+                    .arg(ready[i]).arg(m_retryInterval / 1000));
+        }
+    }
+
+    m_lock.lock();
+    for (uint i = 0; i < added.size(); i++)
+    {
+        m_monitored.remove(added[i]);
+        m_state[added[i]] = kActive;
+    }
+    for (uint i = 0; i < refused.size(); i++)
+        m_nextRetry[refused[i]] = now.addMSecs(m_retryInterval);
+    if (m_monitored.isEmpty())
+        m_timer->stop();
+    m_lock.unlock();
+
+    if (!retry.empty())
+        StartInit(retry, true);
+
+    if (!added.empty())
+        m_inputs->InputsAdded(added.size());
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -0,0 +1,102 @@
+#ifndef _INPUTMONITOR_H
+#define _INPUTMONITOR_H
+
+#include <vector>
+using namespace std;
+
+#include <QWaitCondition>
+#include <QDateTime>
+#include <QObject>
+#include <QString>
+#include <QMutex>
+#include <QMap>
+
+#include "mythtvexp.h"
+#include "mthreadpool.h"
+
+class QTimer;
+
+/** \class InputInitializer
+ *  \brief Creates and initializes the recorders InputMonitor manages, and
+ *         hands over the ones that come back.
+ *
+ *   The backend implements it with TVRec and EncoderLink, tests with a
+ *   fake device.
+ */
+class MTV_PUBLIC InputInitializer
+{
+  public:
+    virtual ~InputInitializer() {}
+
+    /// \brief Returns the device of the input, inputs on the same device
+    ///        are initialized one after the other.
+    virtual QString GetDevice(uint cardid) = 0;
+    /// \brief Initializes the recorder of the input, creating it first
+    ///        when \p create is set.  Called from the pool threads.
+    virtual bool InitInput(uint cardid, bool create) = 0;
+    /// \brief Puts an input that became ready after startup into use.
+    ///        Called from the thread that owns the InputMonitor.
+    virtual bool AddInput(uint cardid) = 0;
+    /// \brief Called after AddInput() added \p count inputs, so the
+    ///        capacity change can be acted on at once.
+    virtual void InputsAdded(uint count) = 0;
+};
+
+/** \class InputMonitor
+ *  \brief Initializes the local capture cards and brings back the ones
+ *         whose device was missing.
+ *
+ *   InitInput() of every card runs in a thread pool, one task per
+ *   device, so a tuner that is slow to answer doesn't hold up the
+ *   others.  Cards that aren't ready when InitInputs() gives up waiting,
+ *   or whose device couldn't be opened, can be handed to Monitor().
+ *   Those are retried periodically, and once one initializes it is
+ *   passed to AddInput() and InputsAdded() is called.
+ */
+class MTV_PUBLIC InputMonitor : public QObject
+{
+    Q_OBJECT
+
+  public:
+    InputMonitor(InputInitializer *inputs, uint checkInterval = 10000,
+                 uint retryInterval = 60000);
+   ~InputMonitor();
+
+    void InitInputs(const vector<uint> &cardids, uint timeout);
+    bool IsReady(uint cardid);
+    bool HasFailed(uint cardid);
+    void Monitor(uint cardid);
+
+    // Called by the init tasks
+    void InitDone(uint cardid, bool ok);
+
+  public slots:
+    void CheckInputs(void);
+
+  private:
+    enum InputState
+    {
+        kInitializing,
+        kReady,         ///< initialized, not added yet
+        kFailed,
+        kActive,
+    };
+
+    void StartInit(const vector<uint> &cardids, bool create);
+
+    InputInitializer         *m_inputs;
+    uint                      m_checkInterval;  ///< in ms, 0 for no timer
+    uint                      m_retryInterval;  ///< in ms
+    MThreadPool               m_pool;
+    QTimer                   *m_timer;
+
+    QMutex                    m_lock;
+    QWaitCondition            m_wait;
+    QMap<uint, InputState>    m_state;      // protected by m_lock
+    QMap<uint, QDateTime>     m_nextRetry;  // protected by m_lock
+    QMap<uint, bool>          m_monitored;  // protected by m_lock
+};
+
+#endif
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
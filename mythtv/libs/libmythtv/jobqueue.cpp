@@ -51,7 +51,14 @@ JobQueue::JobQueue(bool master) :
     runningJobsLock(new QMutex(QMutex::Recursive)),
     isMaster(master),
     queueThread(new MThread("JobQueue", this)),
-    processQueue(false)
+    processQueue(false),
+    queueWakeRequested(false),
+    queueSettingsDirty(true),
+    queueCheckFrequency(30),
+    maxSimultaneousJobs(1),
+    maxTranscodeJobs(0),
+    maxCommFlagJobs(0),
+    maxLoadAverage(0.0)
 {
     jobQueueCPU = gCoreContext->GetNumSetting("JobQueueCPU", 0);
 
@@ -91,6 +98,30 @@ void JobQueue::customEvent(QEvent *e)
         MythEvent *me = (MythEvent *)e;
         QString message = me->Message();
 
+        if (message == "LOCAL_JOBQUEUE_WAKE" || message == "JOBQUEUE_WAKE")
+        {
+            // The master only forwards GLOBAL_ events to the slaves, pass
+            // it on to the mythjobqueue hosts connected to it as well
+            if (message == "LOCAL_JOBQUEUE_WAKE" &&
+                gCoreContext->IsMasterBackend())
+            {
+                MythEvent wake("JOBQUEUE_WAKE");
+                gCoreContext->dispatch(wake);
+            }
+
+            WakeQueue();
+            return;
+        }
+
+        if (message == "CLEAR_SETTINGS_CACHE")
+        {
+            queueThreadCondLock.lock();
+            queueSettingsDirty = true;
+            queueThreadCondLock.unlock();
+            WakeQueue();
+            return;
+        }
+
         if (message.startsWith("LOCAL_JOB"))
         {
             // LOCAL_JOB action ID jobID
@@ -163,6 +194,117 @@ void JobQueue::run(void)
     ProcessQueue();
 }
 
+/** \brief Wakes the queue thread so it rescans the queue immediately.
+ *
+ *  If the thread is busy processing the queue the request is remembered
+ *  and the next wait is skipped, so no notification is ever lost.
+ */
+void JobQueue::WakeQueue(void)
+{
+    QMutexLocker locker(&queueThreadCondLock);
+    queueWakeRequested = true;
+    queueThreadCond.wakeAll();
+}
+
+/** \brief Tells every JobQueue instance that the jobqueue table changed.
+ *
+ *  The event goes to the master backend as a GLOBAL_ event, which the
+ *  master dispatches locally and forwards to the slave backends.  The
+ *  master's JobQueue passes it on to the clients, so both mythbackend
+ *  and mythjobqueue hosts pick up new work without waiting for the next
+ *  JobQueueCheckFrequency poll.
+ */
+void JobQueue::NotifyQueueChanged(void)
+{
+    if (!gCoreContext)
+        return;
+
+    if (gCoreContext->IsMasterBackend())
+    {
+        MythEvent me("GLOBAL_JOBQUEUE_WAKE");
+        gCoreContext->dispatch(me);
+    }
+    else if (gCoreContext->IsBackend())
+    {
+        // SendMessage() would only dispatch it on this slave
+        QStringList strlist("MESSAGE");
+        strlist << "GLOBAL_JOBQUEUE_WAKE";
+        gCoreContext->SendReceiveStringList(strlist);
+    }
+    else
+    {
+        gCoreContext->SendMessage("GLOBAL_JOBQUEUE_WAKE");
+    }
+}
+
+void JobQueue::LoadQueueSettings(void)
+{
+    queueCheckFrequency =
+        gCoreContext->GetNumSetting("JobQueueCheckFrequency", 30);
+    maxSimultaneousJobs =
+        gCoreContext->GetNumSetting("JobQueueMaxSimultaneousJobs", 3);
+    maxTranscodeJobs =
+        gCoreContext->GetNumSetting("JobQueueMaxTranscodeJobs", 0);
+    maxCommFlagJobs =
+        gCoreContext->GetNumSetting("JobQueueMaxCommFlagJobs", 0);
+    maxLoadAverage =
+        gCoreContext->GetFloatSetting("JobQueueMaxLoadAverage", 0.0);
+    jobQueueCPU = gCoreContext->GetNumSetting("JobQueueCPU", 0);
+
+    LOG(VB_JOBQUEUE, LOG_INFO, LOC +
+        QString("Currently set to run up to %1 job(s) max, "
+                "%2 transcode(s), %3 commflag(s), max load %4, "
+                "fallback check every %5 secs.")
+            .arg(maxSimultaneousJobs)
+            .arg(maxTranscodeJobs ? QString::number(maxTranscodeJobs) : "any")
+            .arg(maxCommFlagJobs ? QString::number(maxCommFlagJobs) : "any")
+            .arg(maxLoadAverage > 0.0 ?
+                 QString::number(maxLoadAverage, 'f', 2) : "unlimited")
+            .arg(queueCheckFrequency));
+}
+
+/** \brief Admission policy for starting a new job on this host.
+ *
+ *  Transcodes are CPU bound while commercial flagging is mostly I/O and
+ *  decode bound, so each class can be limited separately on top of the
+ *  overall JobQueueMaxSimultaneousJobs cap.  New jobs are also held back
+ *  while the 1 minute load average is above JobQueueMaxLoadAverage,
+ *  unless nothing is running at all.
+ */
+bool JobQueue::HasCapacityFor(const JobQueueEntry &job,
+                              const QMap<int, int> &runningByType,
+                              QString &reason) const
+{
+    if ((job.type == JOB_TRANSCODE) && (maxTranscodeJobs > 0) &&
+        (runningByType.value(JOB_TRANSCODE, 0) >= maxTranscodeJobs))
+    {
+        reason = QString("%1 transcode job(s) already running")
+            .arg(runningByType.value(JOB_TRANSCODE, 0));
+        return false;
+    }
+
+    if ((job.type == JOB_COMMFLAG) && (maxCommFlagJobs > 0) &&
+        (runningByType.value(JOB_COMMFLAG, 0) >= maxCommFlagJobs))
+    {
+        reason = QString("%1 commflag job(s) already running")
+            .arg(runningByType.value(JOB_COMMFLAG, 0));
+        return false;
+    }
+
+    if ((maxLoadAverage > 0.0) && (jobsRunning > 0))
+    {
+        double loads[3];
+        if ((getloadavg(loads, 3) != -1) && (loads[0] > maxLoadAverage))
+        {
+            reason = QString("load average %1 is above %2")
+                .arg(loads[0], 0, 'f', 2).arg(maxLoadAverage, 0, 'f', 2);
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void JobQueue::ProcessQueue(void)
 {
     LOG(VB_JOBQUEUE, LOG_INFO, LOC + "ProcessQueue() started");
@@ -173,28 +315,30 @@ void JobQueue::ProcessQueue(void)
     //int flags;
     int status;
     QString hostname;
-    int sleepTime;
 
     QMap<int, int> jobStatus;
-    int maxJobs;
+    QMap<int, int> runningByType;
     QString message;
+    QString reason;
     QMap<int, JobQueueEntry> jobs;
     bool atMax = false;
     bool inTimeWindow = true;
     bool startedJobAlready = false;
+    bool reloadSettings;
     QMap<int, RunningJobInfo>::Iterator rjiter;
 
     QMutexLocker locker(&queueThreadCondLock);
     while (processQueue)
     {
+        queueWakeRequested = false;
+        reloadSettings = queueSettingsDirty;
+        queueSettingsDirty = false;
         locker.unlock();
 
         startedJobAlready = false;
-        sleepTime = gCoreContext->GetNumSetting("JobQueueCheckFrequency", 30);
-        maxJobs = gCoreContext->GetNumSetting("JobQueueMaxSimultaneousJobs", 3);
-        LOG(VB_JOBQUEUE, LOG_INFO, LOC +
-            QString("Currently set to run up to %1 job(s) max.")
-                        .arg(maxJobs));
+        if (reloadSettings)
+            LoadQueueSettings();
+        int maxJobs = maxSimultaneousJobs;
 
         jobStatus.clear();
 
@@ -208,6 +352,7 @@ void JobQueue::ProcessQueue(void)
         runningJobsLock->unlock();
 
         jobsRunning = 0;
+        runningByType.clear();
         GetJobsInQueue(jobs);
 
         if (jobs.size())
@@ -222,7 +367,10 @@ void JobQueue::ProcessQueue(void)
                      (status == JOB_STARTING) ||
                      (status == JOB_PAUSED)) &&
                     (hostname == m_hostname))
-                jobsRunning++;
+                {
+                    jobsRunning++;
+                    runningByType[jobs[x].type]++;
+                }
             }
 
             message = QString("Currently Running %1 jobs.")
@@ -435,6 +583,16 @@ void JobQueue::ProcessQueue(void)
                 if (startedJobAlready)
                     continue;
 
+                if ((inTimeWindow) &&
+                    (!HasCapacityFor(jobs[x], runningByType, reason)))
+                {
+                    message = QString("Deferring '%1' job for %2, %3.")
+                                      .arg(JobText(jobs[x].type)).arg(logInfo)
+                                      .arg(reason);
+                    LOG(VB_JOBQUEUE, LOG_INFO, LOC + message);
+                    continue;
+                }
+
                 if ((inTimeWindow) &&
                     (hostname.isEmpty()) &&
                     (!ChangeJobHost(jobID, m_hostname)))
@@ -491,9 +649,12 @@ void JobQueue::ProcessQueue(void)
 
 
         locker.relock();
-        if (processQueue)
+        if (processQueue && !queueWakeRequested)
         {
-            int st = (startedJobAlready) ? (5 * 1000) : (sleepTime * 1000);
+            // Queue changes and finished jobs wake us up through
+            // WakeQueue(), the timeout is only a fallback for changes
+            // made behind our back directly in the database.
+            int st = (startedJobAlready) ? 1000 : (queueCheckFrequency * 1000);
             if (st > 0)
                 queueThreadCond.wait(locker.mutex(), st);
         }
@@ -609,6 +770,8 @@ bool JobQueue::QueueJob(int jobType, uint chanid, const QDateTime &recstartts,
         return false;
     }
 
+    NotifyQueueChanged();
+
     return true;
 }
 
@@ -900,6 +1063,8 @@ bool JobQueue::DeleteJob(int jobID)
         return false;
     }
 
+    NotifyQueueChanged();
+
     return true;
 }
 
@@ -921,6 +1086,11 @@ bool JobQueue::ChangeJobCmds(int jobID, int newCmds)
         return false;
     }
 
+    // Resetting to JOB_RUN is how the queue acknowledges a command,
+    // only new commands need the queue's attention.
+    if (newCmds != JOB_RUN)
+        NotifyQueueChanged();
+
     return true;
 }
 
@@ -943,6 +1113,11 @@ bool JobQueue::ChangeJobCmds(int jobType, uint chanid,
         return false;
     }
 
+    // Resetting to JOB_RUN is how the queue acknowledges a command,
+    // only new commands need the queue's attention.
+    if (newCmds != JOB_RUN)
+        NotifyQueueChanged();
+
     return true;
 }
 
@@ -991,6 +1166,11 @@ bool JobQueue::ChangeJobStatus(int jobID, int newStatus, QString comment)
         return false;
     }
 
+    // A finished job frees a slot and a requeued job is new work,
+    // progress updates while running don't concern the queue.
+    if ((newStatus & JOB_DONE) || (newStatus == JOB_QUEUED))
+        NotifyQueueChanged();
+
     return true;
 }
 
@@ -1833,6 +2013,8 @@ void JobQueue::RemoveRunningJob(int id)
     }
 
     runningJobsLock->unlock();
+
+    WakeQueue();
 }
 
 QString JobQueue::PrettyPrint(off_t bytes)
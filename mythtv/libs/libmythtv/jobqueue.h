@@ -192,6 +192,8 @@ class MTV_PUBLIC JobQueue : public QObject, public QRunnable
     static int GetJobsInQueue(QMap<int, JobQueueEntry> &jobs,
                               int findJobs = JOB_LIST_NOT_DONE);
 
+    static void NotifyQueueChanged(void);
+
     static void RecoverQueue(bool justOld = false);
     static void RecoverOldJobsInQueue()
                                       { RecoverQueue(true); }
@@ -210,6 +212,11 @@ class MTV_PUBLIC JobQueue : public QObject, public QRunnable
     void ProcessJob(JobQueueEntry job);
 
     bool AllowedToRun(JobQueueEntry job);
+    bool HasCapacityFor(const JobQueueEntry &job,
+                        const QMap<int, int> &runningByType,
+                        QString &reason) const;
+    void LoadQueueSettings(void);
+    void WakeQueue(void);
 
     static bool InJobRunWindow(int orStartingWithinMins = 0);
 
@@ -252,6 +259,15 @@ class MTV_PUBLIC JobQueue : public QObject, public QRunnable
     QWaitCondition queueThreadCond;
     QMutex queueThreadCondLock;
     bool processQueue;
+    bool queueWakeRequested;
+    bool queueSettingsDirty;
+
+    // Settings cached by LoadQueueSettings(), only touched by queueThread
+    int queueCheckFrequency;
+    int maxSimultaneousJobs;
+    int maxTranscodeJobs;
+    int maxCommFlagJobs;
+    double maxLoadAverage;
 };
 
 #endif
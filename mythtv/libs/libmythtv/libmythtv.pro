@@ -118,6 +118,7 @@ HEADERS += jobqueue.h
 HEADERS += filtermanager.h          recordingprofile.h
 HEADERS += remoteencoder.h          videosource.h
 HEADERS += cardutil.h               sourceutil.h
+HEADERS += inputmonitor.h
 HEADERS += videometadatautil.h
 HEADERS += vbi608extractor.h
 HEADERS += cc608decoder.h           cc608reader.h
@@ -146,6 +147,7 @@ SOURCES += jobqueue.cpp
 SOURCES += filtermanager.cpp        recordingprofile.cpp
 SOURCES += remoteencoder.cpp        videosource.cpp
 SOURCES += cardutil.cpp             sourceutil.cpp
+SOURCES += inputmonitor.cpp
 SOURCES += videometadatautil.cpp
 SOURCES += vbi608extractor.cpp
 SOURCES += cc608decoder.cpp         cc608reader.cpp
@@ -327,10 +329,10 @@ using_frontend {
     # A/V decoders
     HEADERS += decoderbase.h
     HEADERS += nuppeldecoder.h          avformatdecoder.h
-    HEADERS += privatedecoder.h
+    HEADERS += privatedecoder.h         avprobecache.h
     SOURCES += decoderbase.cpp
     SOURCES += nuppeldecoder.cpp        avformatdecoder.cpp
-    SOURCES += privatedecoder.cpp
+    SOURCES += privatedecoder.cpp       avprobecache.cpp
 
     using_crystalhd {
         DEFINES += USING_CRYSTALHD
@@ -359,6 +361,7 @@ using_frontend {
     HEADERS += videooutbase.h           videoout_null.h
     HEADERS += videobuffers.h           vsync.h
     HEADERS += jitterometer.h           yuv2rgb.h
+    HEADERS += avsynctelemetry.h
     HEADERS += videodisplayprofile.h    mythcodecid.h
     HEADERS += videoouttypes.h          util-osd.h
     HEADERS += videooutwindow.h         videocolourspace.h
@@ -367,6 +370,7 @@ using_frontend {
     SOURCES += videooutbase.cpp         videoout_null.cpp
     SOURCES += videobuffers.cpp         vsync.cpp
     SOURCES += jitterometer.cpp         yuv2rgb.cpp
+    SOURCES += avsynctelemetry.cpp
     SOURCES += videodisplayprofile.cpp  mythcodecid.cpp
     SOURCES += videooutwindow.cpp       util-osd.cpp
     SOURCES += videocolourspace.cpp
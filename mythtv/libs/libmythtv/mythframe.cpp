@@ -24,6 +24,8 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
  *****************************************************************************/
 
+#include <QMutex>
+
 #include <mythtimer.h>
 #include "mythconfig.h"
 #include "mythframe.h"
@@ -300,6 +302,24 @@ static void splitplanes(uint8_t* dstu, int dstu_pitch,
     }
 }
 
+static QMutex   copy_stats_lock;
+static uint64_t copy_stats_copies = 0;
+static uint64_t copy_stats_bytes  = 0;
+
+void framecopy_count(uint64_t bytes)
+{
+    QMutexLocker locker(&copy_stats_lock);
+    copy_stats_copies++;
+    copy_stats_bytes += bytes;
+}
+
+void framecopy_totals(uint64_t &copies, uint64_t &bytes)
+{
+    QMutexLocker locker(&copy_stats_lock);
+    copies = copy_stats_copies;
+    bytes  = copy_stats_bytes;
+}
+
 void framecopy(VideoFrame* dst, const VideoFrame* src, bool useSSE)
 {
     VideoFrameType codec = dst->codec;
@@ -318,6 +338,8 @@ void framecopy(VideoFrame* dst, const VideoFrame* src, bool useSSE)
         int dwidth  = dst->width;
         int dheight = dst->height;
 
+        framecopy_count((uint64_t)width * height * 3 / 2);
+
         if (src->codec == FMT_NV12 &&
             height == dheight && width == dwidth)
         {
@@ -596,6 +618,8 @@ void MythUSWCCopy::copy(VideoFrame *dst, const VideoFrame *src)
     int width   = src->width;
     int height  = src->height;
 
+    framecopy_count((uint64_t)width * height * 3 / 2);
+
     if (src->codec == FMT_NV12)
     {
 #if ARCH_X86
@@ -90,6 +90,12 @@ private:
 void MTV_PUBLIC framecopy(VideoFrame *dst, const VideoFrame *src,
                           bool useSSE = true);
 
+/// Adds a copy or conversion of a whole picture of the given size to the
+/// frame copy totals.  framecopy() and MythUSWCCopy count themselves.
+void MTV_PUBLIC framecopy_count(uint64_t bytes);
+/// Returns the number of picture copies and bytes copied so far.
+void MTV_PUBLIC framecopy_totals(uint64_t &copies, uint64_t &bytes);
+
 static inline void init(VideoFrame *vf, VideoFrameType _codec,
                         unsigned char *_buf, int _width, int _height, int _size,
                         const int *p = 0,
@@ -227,8 +227,11 @@ MythPlayer::MythPlayer(PlayerFlags flags)
       prevtc(0),                    prevrp(0),
       // LiveTVChain stuff
       m_tv(NULL),                   isDummy(false),
+      zapWaitingForFrame(false),
       // Debugging variables
-      output_jmeter(new Jitterometer(LOC))
+      output_jmeter(new Jitterometer(LOC)),
+      copystats_copies(0),          copystats_bytes(0),
+      copystats_frames(0)
 {
     memset(&tc_lastval, 0, sizeof(tc_lastval));
     memset(&tc_wrap,    0, sizeof(tc_wrap));
@@ -256,6 +259,10 @@ MythPlayer::MythPlayer(PlayerFlags flags)
     uint tmp = mypage.toInt(&valid, 16);
     ttPageNum = (valid) ? tmp : ttPageNum;
     cc608.SetTTPageNum(ttPageNum);
+
+    // Keep the timings of the last 10 minutes of 60Hz playback
+    if (getenv("MYTHTV_AVSYNC_CSV"))
+        avsync_telemetry.Resize(36000);
 }
 
 MythPlayer::~MythPlayer(void)
@@ -314,6 +321,9 @@ MythPlayer::~MythPlayer(void)
         output_jmeter = NULL;
     }
 
+    if (avsync_telemetry.IsEnabled())
+        avsync_telemetry.WriteCSV(getenv("MYTHTV_AVSYNC_CSV"));
+
     if (detect_letter_box)
     {
         delete detect_letter_box;
@@ -1152,6 +1162,7 @@ void MythPlayer::ReleaseNextVideoFrame(VideoFrame *buffer,
         WrapTimecode(timecode, TC_VIDEO);
     buffer->timecode = timecode;
     m_latestVideoTimecode = timecode;
+    avsync_telemetry.FrameReady(timecode, VideoSync::GetTime());
 
     if (videoOutput)
         videoOutput->ReleaseFrame(buffer);
@@ -1854,6 +1865,10 @@ void MythPlayer::AVSync(VideoFrame *buffer, bool limit_delay)
     bool dropframe = false;
     QString dbg;
 
+    AVSyncTelemetry::Sample sample;
+    sample.frame    = framesPlayed;
+    sample.timecode = timecode;
+
     if (avsync_predictor_enabled)
     {
         avsync_predictor += frame_interval;
@@ -1889,6 +1904,7 @@ void MythPlayer::AVSync(VideoFrame *buffer, bool limit_delay)
         lastsync = true;
         //currentaudiotime = AVSyncGetAudiotime();
         LOG(VB_PLAYBACK, LOG_INFO, LOC + dbg + "dropping frame to catch up.");
+        sample.dropped = true;
         if (!audio.IsPaused() && max_video_behind)
         {
             audio.Pause(true);
@@ -1909,6 +1925,17 @@ void MythPlayer::AVSync(VideoFrame *buffer, bool limit_delay)
         //currentaudiotime = AVSyncGetAudiotime();
         LOG(VB_PLAYBACK | VB_TIMESTAMP, LOG_INFO, LOC + "AVSync show");
         videoOutput->Show(ps);
+        sample.target    = videosync->GetNextTrigger();
+        sample.presented = VideoSync::GetTime();
+
+        if (zapWaitingForFrame)
+        {
+            LOG(VB_CHANNEL, LOG_INFO, LOC +
+                QString("Channel change: first frame shown after %1 ms")
+                    .arg(zapTimer.elapsed()));
+            zapWaitingForFrame = false;
+            zapTimer.stop();
+        }
 
         if (videoOutput->IsErrored())
         {
@@ -1951,6 +1978,8 @@ void MythPlayer::AVSync(VideoFrame *buffer, bool limit_delay)
     {
         vsync_delay_clock = videosync->WaitForFrame(frameDelay);
         //currentaudiotime = AVSyncGetAudiotime();
+        sample.target    = videosync->GetNextTrigger();
+        sample.presented = VideoSync::GetTime();
     }
 
     if (output_jmeter && output_jmeter->RecordCycleTime())
@@ -1978,6 +2007,7 @@ void MythPlayer::AVSync(VideoFrame *buffer, bool limit_delay)
     {
         // must be sampled here due to Show delays
         int64_t currentaudiotime = audio.GetAudioTime();
+        sample.audiotime = currentaudiotime;
         LOG(VB_PLAYBACK | VB_TIMESTAMP, LOG_INFO, LOC +
             QString("A/V timecodes audio %1 video %2 frameinterval %3 "
                     "avdel %4 avg %5 tcoffset %6 avp %7 avpen %8 avdc %9")
@@ -2060,6 +2090,10 @@ void MythPlayer::AVSync(VideoFrame *buffer, bool limit_delay)
         LOG(VB_PLAYBACK | VB_TIMESTAMP, LOG_INFO, LOC +
             QString("A/V no sync proc ns:%1").arg(normal_speed));
     }
+
+    sample.avsync_delay = avsync_delay;
+    sample.adjustment   = avsync_adjustment;
+    avsync_telemetry.AddSample(sample);
 }
 
 void MythPlayer::RefreshPauseFrame(void)
@@ -2551,6 +2585,17 @@ void MythPlayer::ResetPlaying(bool resetframes)
     }
 }
 
+/** \brief Marks the start of a LiveTV channel change.
+ *
+ *   The time until the first frame of the new channel is shown
+ *   is logged, see JumpToProgram() and AVSync().
+ */
+void MythPlayer::StartZapTimer(void)
+{
+    zapWaitingForFrame = false;
+    zapTimer.start();
+}
+
 void MythPlayer::CheckTVChain(void)
 {
     bool last = !(player_ctx->tvchain->HasNext());
@@ -2827,6 +2872,14 @@ void MythPlayer::JumpToProgram(void)
 
     player_ctx->SetPlayerChangingBuffers(false);
     LOG(VB_PLAYBACK, LOG_INFO, LOC + "JumpToProgram - end");
+
+    if (zapTimer.isRunning())
+    {
+        LOG(VB_CHANNEL, LOG_INFO, LOC +
+            QString("Channel change: new program opened after %1 ms")
+                .arg(zapTimer.elapsed()));
+        zapWaitingForFrame = true;
+    }
 }
 
 bool MythPlayer::StartPlaying(void)
@@ -4437,7 +4490,11 @@ char *MythPlayer::GetScreenGrabAtFrame(uint64_t frameNum, bool absolute,
     memset(&orig,   0, sizeof(AVPicture));
     memset(&retbuf, 0, sizeof(AVPicture));
 
-    if (OpenFile(0) < 0)
+    // Further grabs from the same file reuse the open decoder and video
+    // output, so batched previews only pay for a seek and one decode.
+    bool reuse = decoder && videoOutput;
+
+    if (!reuse && OpenFile(0) < 0)
     {
         LOG(VB_GENERAL, LOG_ERR, LOC + "Could not open file for preview.");
         return NULL;
@@ -4460,7 +4517,7 @@ char *MythPlayer::GetScreenGrabAtFrame(uint64_t frameNum, bool absolute,
         return (char*) outputbuf;
     }
 
-    if (!InitVideo())
+    if (!reuse && !InitVideo())
     {
         LOG(VB_GENERAL, LOG_ERR, LOC +
             "Unable to initialize video for screen grab.");
@@ -4565,7 +4622,11 @@ void MythPlayer::SeekForScreenGrab(uint64_t &number, uint64_t frameNum,
     }
 
     DiscardVideoFrame(videoOutput->GetLastDecodedFrame());
-    DoJumpToFrame(number, kInaccuracyNone);
+
+    // An approximate position is good enough for a preview, so let the
+    // decoder stop at the nearest keyframe from the position map instead
+    // of decoding forward through the GOP to the exact frame.
+    DoJumpToFrame(number, absolute ? kInaccuracyNone : kInaccuracyFull);
 }
 
 /** \fn MythPlayer::GetRawVideoFrame(long long)
@@ -4826,6 +4887,22 @@ void MythPlayer::GetPlaybackData(InfoMap &infoMap)
             .arg(output_jmeter->GetLastSD(), 0, 'f', 2);
         infoMap["load"] = output_jmeter->GetLastCPUStats();
     }
+
+    // Whole picture copies per frame played since the last update
+    uint64_t copies, bytes;
+    framecopy_totals(copies, bytes);
+    uint64_t frames = framesPlayed;
+    if (frames > copystats_frames && copies >= copystats_copies)
+    {
+        double played = frames - copystats_frames;
+        infoMap["framecopies"] = QString("%1 (%2 KB)")
+            .arg((copies - copystats_copies) / played, 0, 'f', 2)
+            .arg((bytes - copystats_bytes) / played / 1024, 0, 'f', 0);
+    }
+    copystats_copies = copies;
+    copystats_bytes  = bytes;
+    copystats_frames = frames;
+
     GetCodecDescription(infoMap);
 }
 
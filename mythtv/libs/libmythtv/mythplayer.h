@@ -14,6 +14,7 @@
 #include "ringbuffer.h"
 #include "osd.h"
 #include "jitterometer.h"
+#include "avsynctelemetry.h"
 #include "videooutbase.h"
 #include "teletextreader.h"
 #include "subtitlereader.h"
@@ -33,6 +34,7 @@
 #include "mythtvexp.h"
 
 #include "filter.h"
+#include "mythtimer.h"
 
 using namespace std;
 
@@ -313,6 +315,7 @@ class MTV_PUBLIC MythPlayer
     // LiveTV public stuff
     void CheckTVChain();
     void FileChangedCallback();
+    void StartZapTimer(void);
 
     // Chapter public stuff
     virtual int  GetNumChapters(void);
@@ -826,9 +829,18 @@ class MTV_PUBLIC MythPlayer
     // LiveTV
     TV *m_tv;
     bool isDummy;
+    /// Time since the channel change key press, see StartZapTimer()
+    MythTimer zapTimer;
+    bool      zapWaitingForFrame;
 
     // Debugging variables
     Jitterometer *output_jmeter;
+    /// Per frame A/V sync timings, see MYTHTV_AVSYNC_CSV
+    AVSyncTelemetry avsync_telemetry;
+    /// Frame copy totals and frames played when GetPlaybackData() last ran
+    uint64_t   copystats_copies;
+    uint64_t   copystats_bytes;
+    uint64_t   copystats_frames;
 
   private:
     void syncWithAudioStretch();
@@ -111,6 +111,85 @@ void PreviewGenerator::AttachSignals(QObject *obj)
     m_listener = obj;
 }
 
+/** \brief Returns true if the preview \p other can be generated
+ *         by this one while the recording is open.
+ *
+ *   Only previews of the same recording with an explicit capture time
+ *   and output file are batched, default previews each have their own
+ *   bookmark dependent capture time and output file.  Output files with
+ *   a ';' can't be passed in mythpreviewgen's --batch and aren't batched.
+ */
+bool PreviewGenerator::CanBatch(const PreviewGenerator &other) const
+{
+    return (&other != this) &&
+        (other.m_pathname == m_pathname) &&
+        (other.m_mode == m_mode) &&
+        (other.m_captureTime >= 0) &&
+        !other.m_outFileName.isEmpty() &&
+        !other.m_outFileName.contains(';');
+}
+
+void PreviewGenerator::AddToBatch(PreviewGenerator *other)
+{
+    QMutexLocker locker(&m_previewLock);
+    m_batch.push_back(other);
+}
+
+uint PreviewGenerator::GetBatchSize(void) const
+{
+    QMutexLocker locker(const_cast<QMutex*>(&m_previewLock));
+    return m_batch.size();
+}
+
+/** \brief Serializes the batched previews for mythpreviewgen's --batch
+ *
+ *   Each preview is "<s|f><time>:<width>x<height>:<outfile>", previews
+ *   are separated by ';'.
+ */
+QString PreviewGenerator::GetBatchArgs(void) const
+{
+    QMutexLocker locker(const_cast<QMutex*>(&m_previewLock));
+    QStringList args;
+    QList<PreviewGenerator*>::const_iterator it = m_batch.begin();
+    for (; it != m_batch.end(); ++it)
+    {
+        args.push_back(QString("%1%2:%3x%4:%5")
+                       .arg((*it)->m_timeInSeconds ? "s" : "f")
+                       .arg((*it)->m_captureTime)
+                       .arg((*it)->m_outSize.width())
+                       .arg((*it)->m_outSize.height())
+                       .arg((*it)->m_outFileName));
+    }
+    return args.join(";");
+}
+
+void PreviewGenerator::NotifyListener(bool ok, const QString &msg)
+{
+    QMutexLocker locker(&m_previewLock);
+    if (!m_listener)
+        return;
+
+    QString output_fn = m_outFileName.isEmpty() ?
+        (m_programInfo.GetPathname()+".png") : m_outFileName;
+
+    QDateTime dt;
+    if (ok)
+    {
+        QFileInfo fi(output_fn);
+        if (fi.exists())
+            dt = fi.lastModified();
+    }
+
+    QString message = (ok) ? "PREVIEW_SUCCESS" : "PREVIEW_FAILED";
+    QStringList list;
+    list.push_back(m_programInfo.MakeUniqueKey());
+    list.push_back(output_fn);
+    list.push_back(msg);
+    list.push_back(dt.isValid()?dt.toUTC().toString(Qt::ISODate):"");
+    list.push_back(m_token);
+    QCoreApplication::postEvent(m_listener, new MythEvent(message, list));
+}
+
 /** \fn PreviewGenerator::RunReal(void)
  *  \brief This call creates a preview without starting a new thread.
  */
@@ -168,29 +247,7 @@ bool PreviewGenerator::RunReal(void)
         msg = "Could not access recording";
     }
 
-    QMutexLocker locker(&m_previewLock);
-    if (m_listener)
-    {
-        QString output_fn = m_outFileName.isEmpty() ?
-            (m_programInfo.GetPathname()+".png") : m_outFileName;
-
-        QDateTime dt;
-        if (ok)
-        {
-            QFileInfo fi(output_fn);
-            if (fi.exists())
-                dt = fi.lastModified();
-        }
-
-        QString message = (ok) ? "PREVIEW_SUCCESS" : "PREVIEW_FAILED";
-        QStringList list;
-        list.push_back(m_programInfo.MakeUniqueKey());
-        list.push_back(output_fn);
-        list.push_back(msg);
-        list.push_back(dt.isValid()?dt.toUTC().toString(Qt::ISODate):"");
-        list.push_back(m_token);
-        QCoreApplication::postEvent(m_listener, new MythEvent(message, list));
-    }
+    NotifyListener(ok, msg);
 
     return ok;
 }
@@ -249,6 +306,10 @@ bool PreviewGenerator::Run(void)
         if (!m_outFileName.isEmpty())
             cmdargs << "--outfile" << m_outFileName;
 
+        QString batch = GetBatchArgs();
+        if (!batch.isEmpty())
+            cmdargs << "--batch" << batch;
+
         // Timeout in 30s
         MythSystemLegacy *ms = new MythSystemLegacy(command, cmdargs,
                                         kMSDontBlockInputDevs |
@@ -259,7 +320,8 @@ bool PreviewGenerator::Run(void)
         ms->SetNice(10);
         ms->SetIOPrio(7);
 
-        ms->Run(30);
+        // Give batches a bit more time, the recording is only opened once.
+        ms->Run(30 + 5 * GetBatchSize());
         uint ret = ms->Wait();
         delete ms;
 
@@ -309,33 +371,40 @@ bool PreviewGenerator::Run(void)
         }
     }
 
-    QMutexLocker locker(&m_previewLock);
-
-    // Backdate file to start of preview time in case a bookmark was made
-    // while we were generating the preview.
-    QString output_fn = m_outFileName.isEmpty() ?
-        (m_programInfo.GetPathname()+".png") : m_outFileName;
-
-    QDateTime dt;
-    if (ok)
+    // The previews batched with this one were written by the same
+    // mythpreviewgen run, report each of them to its requester.
+    QList<PreviewGenerator*> batched;
     {
-        QFileInfo fi(output_fn);
-        if (fi.exists())
-            dt = fi.lastModified();
+        QMutexLocker locker(&m_previewLock);
+        batched.swap(m_batch);
     }
-
-    QString message = (ok) ? "PREVIEW_SUCCESS" : "PREVIEW_FAILED";
-    if (m_listener)
+    QList<PreviewGenerator*>::iterator it = batched.begin();
+    for (; it != batched.end(); ++it)
     {
-        QStringList list;
-        list.push_back(m_programInfo.MakeUniqueKey());
-        list.push_back(output_fn);
-        list.push_back(msg);
-        list.push_back(dt.isValid()?dt.toUTC().toString(Qt::ISODate):"");
-        list.push_back(m_token);
-        QCoreApplication::postEvent(m_listener, new MythEvent(message, list));
+        if (!local_ok)
+        {
+            // Nothing was generated for the batch, run each on its own.
+            (*it)->Run();
+            continue;
+        }
+
+        QString outname = (*it)->m_outFileName;
+        if (QFileInfo(outname).fileName() == outname)
+        {
+            StorageGroup sgroup;
+            QString tmpFile = sgroup.FindFile(outname);
+            outname = (tmpFile.isEmpty()) ? outname : tmpFile;
+        }
+
+        QFileInfo fi(outname);
+        bool batch_ok = (fi.exists() && fi.isReadable() &&
+                         fi.size() && fi.lastModified() >= dtm.addSecs(-1));
+        (*it)->NotifyListener(
+            batch_ok, batch_ok ? msg + " (batched)" : "Batched preview failed");
     }
 
+    NotifyListener(ok, msg);
+
     return ok;
 }
 
@@ -578,9 +647,21 @@ bool PreviewGenerator::SavePreview(const QString &filename,
     }
 
     ppw = max(1.0f, ppw);
-    pph = max(1.0f, pph);;
+    pph = max(1.0f, pph);
 
-    QImage small_img = img.scaled((int) ppw, (int) pph,
+    // Smooth scaling a full HD frame down to a thumbnail is slow, so do
+    // most of the reduction with a fast nearest neighbour pass first.
+    // Stopping at twice the final size keeps the result just as sharp.
+    QImage fast_img;
+    const QImage *src_img = &img;
+    if ((img.width() > 4 * ppw) && (img.height() > 4 * pph))
+    {
+        fast_img = img.scaled((int) (2 * ppw), (int) (2 * pph),
+            Qt::IgnoreAspectRatio, Qt::FastTransformation);
+        src_img = &fast_img;
+    }
+
+    QImage small_img = src_img->scaled((int) ppw, (int) pph,
         Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
 
     QTemporaryFile f(QFileInfo(filename).absoluteFilePath()+".XXXXXX");
@@ -610,15 +691,15 @@ bool PreviewGenerator::SavePreview(const QString &filename,
     return false;
 }
 
-bool PreviewGenerator::LocalPreviewRun(void)
+/** \brief Returns the capture time for this preview.
+ *
+ *   This is the requested time if one was set, otherwise the bookmark,
+ *   and failing that a third of the way into the program.
+ */
+long long PreviewGenerator::GetCaptureTime(bool &time_in_secs) const
 {
-    m_programInfo.MarkAsInUse(true, kPreviewGeneratorInUseID);
-
-    float aspect = 0;
-    int   width, height, sz;
     long long captime = m_captureTime;
-
-    QDateTime dt = MythDate::current();
+    time_in_secs = m_timeInSeconds;
 
     if (captime > 0)
         LOG(VB_GENERAL, LOG_INFO, "Preview from time spec");
@@ -628,7 +709,7 @@ bool PreviewGenerator::LocalPreviewRun(void)
         captime = m_programInfo.QueryBookmark();
         if (captime > 0)
         {
-            m_timeInSeconds = false;
+            time_in_secs = false;
             LOG(VB_GENERAL, LOG_INFO,
                 QString("Preview from bookmark (frame %1)").arg(captime));
         }
@@ -638,7 +719,7 @@ bool PreviewGenerator::LocalPreviewRun(void)
 
     if (captime <= 0)
     {
-        m_timeInSeconds = true;
+        time_in_secs = true;
         int startEarly = 0;
         int programDuration = 0;
         int preroll =  gCoreContext->GetNumSetting("RecordPreRoll", 0);
@@ -669,10 +750,22 @@ bool PreviewGenerator::LocalPreviewRun(void)
             QString("Preview at calculated offset (%1 seconds)").arg(captime));
     }
 
+    return captime;
+}
+
+/// Grabs this preview's frame from an already open recording and saves it.
+bool PreviewGenerator::GrabAndSave(PlayerContext *ctx)
+{
+    float aspect = 0;
+    int   width, height, sz;
+    bool  time_in_secs;
+    long long captime = GetCaptureTime(time_in_secs);
+
+    QDateTime dt = MythDate::current();
+
     width = height = sz = 0;
     unsigned char *data = (unsigned char*)
-        GetScreenGrab(m_programInfo, m_pathname,
-                      captime, m_timeInSeconds,
+        GetScreenGrab(ctx, m_pathname, captime, time_in_secs,
                       sz, width, height, aspect);
 
     QString outname = CreateAccessibleFilename(m_pathname, m_outFileName);
@@ -696,6 +789,37 @@ bool PreviewGenerator::LocalPreviewRun(void)
 
     delete[] data;
 
+    return ok;
+}
+
+bool PreviewGenerator::LocalPreviewRun(void)
+{
+    m_programInfo.MarkAsInUse(true, kPreviewGeneratorInUseID);
+
+    bool ok = false;
+    PlayerContext *ctx = CreateGrabContext(m_programInfo, m_pathname);
+    if (ctx)
+    {
+        ok = GrabAndSave(ctx);
+
+        // Batched previews reuse the open decoder, so each one
+        // only costs a keyframe seek and a single frame decode.
+        QMutexLocker locker(&m_previewLock);
+        QList<PreviewGenerator*>::iterator it = m_batch.begin();
+        for (; it != m_batch.end(); ++it)
+        {
+            if (!(*it)->GrabAndSave(ctx))
+            {
+                LOG(VB_GENERAL, LOG_ERR, LOC +
+                    QString("Batched preview '%1' failed")
+                        .arg((*it)->m_outFileName));
+            }
+        }
+        locker.unlock();
+
+        delete ctx;
+    }
+
     m_programInfo.MarkAsInUse(false, kPreviewGeneratorInUseID);
 
     return ok;
@@ -756,36 +880,16 @@ bool PreviewGenerator::IsLocal(void) const
 }
 
 /**
- *  \brief Returns a PIX_FMT_RGBA32 buffer containg a frame from the video.
+ *  \brief Opens a recording for GetScreenGrab().
  *
  *  \param pginfo       Recording to grab from.
  *  \param filename     File containing recording.
- *  \param seektime     Seconds or frames into the video to seek before
- *                      capturing a frame.
- *  \param time_in_secs if true time is in seconds, otherwise it is in frames.
- *  \param bufferlen    Returns size of buffer returned (in bytes).
- *  \param video_width  Returns width of frame grabbed.
- *  \param video_height Returns height of frame grabbed.
- *  \param video_aspect Returns aspect ratio of frame grabbed.
- *  \return Buffer allocated with new containing frame in RGBA32 format if
- *          successful, NULL otherwise.
+ *  \return PlayerContext with a video-less player the caller must delete,
+ *          NULL if the file could not be opened.
  */
-char *PreviewGenerator::GetScreenGrab(
-    const ProgramInfo &pginfo, const QString &filename,
-    long long seektime, bool time_in_secs,
-    int &bufferlen,
-    int &video_width, int &video_height, float &video_aspect)
+PlayerContext *PreviewGenerator::CreateGrabContext(
+    const ProgramInfo &pginfo, const QString &filename)
 {
-    (void) pginfo;
-    (void) filename;
-    (void) seektime;
-    (void) time_in_secs;
-    (void) bufferlen;
-    (void) video_width;
-    (void) video_height;
-    char *retbuf = NULL;
-    bufferlen = 0;
-
     if (!MSqlQuery::testDBConnection())
     {
         LOG(VB_GENERAL, LOG_ERR, LOC + "Previewer could not connect to DB.");
@@ -821,6 +925,36 @@ char *PreviewGenerator::GetScreenGrab(
     ctx->SetPlayer(new MythPlayer((PlayerFlags)(kAudioMuted | kVideoIsNull | kNoITV)));
     ctx->player->SetPlayerInfo(NULL, NULL, ctx);
 
+    return ctx;
+}
+
+/**
+ *  \brief Returns a PIX_FMT_RGBA32 buffer containg a frame from the video.
+ *
+ *  \param ctx          Context returned by CreateGrabContext().
+ *  \param filename     File containing recording.
+ *  \param seektime     Seconds or frames into the video to seek before
+ *                      capturing a frame.
+ *  \param time_in_secs if true time is in seconds, otherwise it is in frames.
+ *  \param bufferlen    Returns size of buffer returned (in bytes).
+ *  \param video_width  Returns width of frame grabbed.
+ *  \param video_height Returns height of frame grabbed.
+ *  \param video_aspect Returns aspect ratio of frame grabbed.
+ *  \return Buffer allocated with new containing frame in RGBA32 format if
+ *          successful, NULL otherwise.
+ */
+char *PreviewGenerator::GetScreenGrab(
+    PlayerContext *ctx, const QString &filename,
+    long long seektime, bool time_in_secs,
+    int &bufferlen,
+    int &video_width, int &video_height, float &video_aspect)
+{
+    char *retbuf = NULL;
+    bufferlen = 0;
+
+    if (!ctx || !ctx->player)
+        return NULL;
+
     if (time_in_secs)
         retbuf = ctx->player->GetScreenGrab(seektime, bufferlen,
                                     video_width, video_height, video_aspect);
@@ -829,8 +963,6 @@ char *PreviewGenerator::GetScreenGrab(
             seektime, true, bufferlen,
             video_width, video_height, video_aspect);
 
-    delete ctx;
-
     if (retbuf)
     {
         LOG(VB_GENERAL, LOG_INFO, LOC +
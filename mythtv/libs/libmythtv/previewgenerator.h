@@ -7,6 +7,7 @@
 #include <QString>
 #include <QMutex>
 #include <QSize>
+#include <QList>
 #include <QMap>
 #include <QSet>
 
@@ -16,6 +17,7 @@
 #include "mythdate.h"
 
 class PreviewGenerator;
+class PlayerContext;
 class QByteArray;
 class MythSocket;
 class QObject;
@@ -31,7 +33,8 @@ class MTV_PUBLIC PreviewGenerator : public QObject, public MThread
                               long long      previewSeconds,
                               const QSize   &previewSize,
                               const QString &infile,
-                              const QString &outfile);
+                              const QString &outfile,
+                              const QString &batch);
 
     Q_OBJECT
 
@@ -62,6 +65,10 @@ class MTV_PUBLIC PreviewGenerator : public QObject, public MThread
 
     QString GetToken(void) const { return m_token; }
 
+    bool CanBatch(const PreviewGenerator &other) const;
+    void AddToBatch(PreviewGenerator *other);
+    uint GetBatchSize(void) const;
+
     void run(void); // MThread
     bool Run(void);
 
@@ -79,8 +86,14 @@ class MTV_PUBLIC PreviewGenerator : public QObject, public MThread
     bool IsLocal(void) const;
 
     bool RunReal(void);
-
-    static char *GetScreenGrab(const ProgramInfo &pginfo,
+    void NotifyListener(bool ok, const QString &msg);
+    long long GetCaptureTime(bool &time_in_secs) const;
+    bool GrabAndSave(PlayerContext *ctx);
+    QString GetBatchArgs(void) const;
+
+    static PlayerContext *CreateGrabContext(const ProgramInfo &pginfo,
+                                            const QString     &filename);
+    static char *GetScreenGrab(PlayerContext     *ctx,
                                const QString     &filename,
                                long long          seektime,
                                bool               time_in_secs,
@@ -122,6 +135,10 @@ class MTV_PUBLIC PreviewGenerator : public QObject, public MThread
     QString            m_token;
     bool               m_gotReply;
     bool               m_pixmapOk;
+
+    /// Other previews of the same recording generated by this one,
+    /// owned by the PreviewGeneratorQueue or mythpreviewgen.
+    QList<PreviewGenerator*> m_batch;
 };
 
 #endif // PREVIEW_GENERATOR_H_
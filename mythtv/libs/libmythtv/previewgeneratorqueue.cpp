@@ -25,6 +25,7 @@ using std::max;
 #define LOC QString("PreviewQueue: ")
 
 PreviewGeneratorQueue *PreviewGeneratorQueue::s_pgq = NULL;
+const uint PreviewGeneratorQueue::kMaxBatchSize = 8;
 
 void PreviewGeneratorQueue::CreatePreviewGeneratorQueue(
     PreviewGenerator::Mode mode,
@@ -183,8 +184,10 @@ bool PreviewGeneratorQueue::event(QEvent *e)
 
             if ((*it).gen)
                 (*it).gen->deleteLater();
+            bool batched        = (*it).genBatched;
             (*it).gen           = NULL;
             (*it).genStarted    = false;
+            (*it).genBatched    = false;
             if (me->Message() == "PREVIEW_SUCCESS")
             {
                 (*it).attempts      = 0;
@@ -224,7 +227,8 @@ bool PreviewGeneratorQueue::event(QEvent *e)
                 (*it).tokens.clear();
             }
 
-            m_running = (m_running > 0) ? m_running - 1 : 0;
+            if (!batched)
+                m_running = (m_running > 0) ? m_running - 1 : 0;
         }
 
         UpdatePreviewGeneratorThreads();
@@ -459,21 +463,51 @@ void PreviewGeneratorQueue::IncPreviewGeneratorPriority(
     }
 }
 
+/** \brief Starts queued PreviewGenerators until all threads are busy.
+ *
+ *   The most recently requested previews, usually the ones on screen,
+ *   are started first.  Other queued previews of the same recording are
+ *   handed to the started generator, so the recording is only opened
+ *   once for all of them.
+ */
 void PreviewGeneratorQueue::UpdatePreviewGeneratorThreads(void)
 {
     QMutexLocker locker(&m_lock);
     QStringList &q = m_queue;
-    if (!q.empty() && (m_running < m_maxThreads))
+    while (!q.empty() && (m_running < m_maxThreads))
     {
         QString fn = q.back();
         q.pop_back();
         PreviewMap::iterator it = m_previewMap.find(fn);
-        if (it != m_previewMap.end() && (*it).gen && !(*it).genStarted)
+        if (it == m_previewMap.end() || !(*it).gen || (*it).genStarted)
+            continue;
+
+        PreviewGenerator *gen = (*it).gen;
+        for (int i = q.size() - 1;
+             (i >= 0) && (gen->GetBatchSize() < kMaxBatchSize); --i)
         {
-            m_running++;
-            (*it).gen->start();
-            (*it).genStarted = true;
+            PreviewMap::iterator bit = m_previewMap.find(q[i]);
+            if (bit == m_previewMap.end() || !(*bit).gen ||
+                (*bit).genStarted || !gen->CanBatch(*(*bit).gen))
+            {
+                continue;
+            }
+            gen->AddToBatch((*bit).gen);
+            (*bit).genStarted = true;
+            (*bit).genBatched = true;
+            q.removeAt(i);
         }
+
+        if (gen->GetBatchSize())
+        {
+            LOG(VB_PLAYBACK, LOG_INFO, LOC +
+                QString("Generating %1 more preview(s) together with '%2'")
+                    .arg(gen->GetBatchSize()).arg(fn));
+        }
+
+        m_running++;
+        gen->start();
+        (*it).genStarted = true;
     }
 }
 
@@ -19,10 +19,13 @@ class PreviewGenState
 {
   public:
     PreviewGenState() :
-        gen(NULL), genStarted(false),
+        gen(NULL), genStarted(false), genBatched(false),
         attempts(0), lastBlockTime(0) {}
     PreviewGenerator *gen;
     bool              genStarted;
+    /// generated in a batch by the PreviewGenerator of another preview
+    /// of the same recording, uses no thread
+    bool              genBatched;
     uint              attempts;
     uint              lastBlockTime;
     QDateTime         blockRetryUntil;
@@ -91,6 +94,9 @@ class MTV_PUBLIC PreviewGeneratorQueue : public QObject, public MThread
     uint                   m_maxThreads;
     uint                   m_maxAttempts;
     uint                   m_minBlockSeconds;
+
+    /// Max number of previews of one recording generated together
+    static const uint      kMaxBatchSize;
 };
 
 #endif // _PREVIEW_GENERATOR_QUEUE_H_
@@ -0,0 +1,3 @@
+#include "test_avsync.h"
+
+QTEST_APPLESS_MAIN(TestAVSync)
@@ -0,0 +1,148 @@
+/*
+ *  Class TestAVSync
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+using namespace std;
+
+#include <QtTest/QtTest>
+#include <QString>
+#include <QFile>
+#include <QDir>
+
+#include "avsynctelemetry.h"
+#include "vsync.h"
+
+#define FRAME_INTERVAL  16683   // 59.94 Hz, in usecs
+#define FRAMES          120
+
+class TestAVSync: public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void RingKeepsNewestSamples(void)
+    {
+        AVSyncTelemetry telemetry(4);
+        for (int i = 0; i < 6; i++)
+        {
+            AVSyncTelemetry::Sample sample;
+            sample.frame = i;
+            telemetry.AddSample(sample);
+        }
+
+        QVector<AVSyncTelemetry::Sample> samples = telemetry.GetSamples();
+        QCOMPARE(samples.size(), 4);
+        QCOMPARE(samples.first().frame, 2LL);
+        QCOMPARE(samples.last().frame, 5LL);
+    }
+
+    void DisabledRecordsNothing(void)
+    {
+        AVSyncTelemetry telemetry;
+        AVSyncTelemetry::Sample sample;
+        telemetry.FrameReady(40, 1000);
+        telemetry.AddSample(sample);
+        QVERIFY(!telemetry.IsEnabled());
+        QVERIFY(telemetry.GetSamples().isEmpty());
+    }
+
+    void ReadyTimeMatchesTimecode(void)
+    {
+        AVSyncTelemetry telemetry(8);
+        telemetry.FrameReady(40, 1000);
+        telemetry.FrameReady(80, 2000);
+
+        AVSyncTelemetry::Sample sample;
+        sample.timecode = 80;
+        telemetry.AddSample(sample);
+        QCOMPARE(sample.ready, (int64_t)2000);
+
+        AVSyncTelemetry::Sample unknown;
+        unknown.timecode = 120;
+        telemetry.AddSample(unknown);
+        QCOMPARE(unknown.ready, (int64_t)0);
+    }
+
+    void WritesCSV(void)
+    {
+        QString filename = QString("%1/test_avsync_%2.csv")
+            .arg(QDir::tempPath()).arg(QCoreApplication::applicationPid());
+
+        AVSyncTelemetry telemetry(8);
+        for (int i = 0; i < 3; i++)
+        {
+            AVSyncTelemetry::Sample sample;
+            sample.frame     = i;
+            sample.target    = 1000 * i;
+            sample.presented = 1000 * i + 250;
+            telemetry.AddSample(sample);
+        }
+        QVERIFY(telemetry.WriteCSV(filename));
+
+        QFile file(filename);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QStringList lines = QString(file.readAll()).split('\n',
+                                                        QString::SkipEmptyParts);
+        file.close();
+        QFile::remove(filename);
+
+        QCOMPARE(lines.size(), 4);
+        QVERIFY(lines[0].startsWith("frame,"));
+        QCOMPARE(lines[2].section(',', 6, 6), QString("250"));
+    }
+
+    // The sync method MythPlayer uses without a display.  Checks that
+    // every frame was recorded in order and not before its trigger, how
+    // late it was depends on how busy the machine is and is just reported.
+    void HeadlessSyncRecordsFrames(void)
+    {
+        USleepVideoSync vsync(NULL, FRAME_INTERVAL, 0, false);
+        QVERIFY(vsync.TryInit());
+
+        AVSyncTelemetry telemetry(FRAMES);
+        vsync.Start();
+        for (int i = 0; i < FRAMES; i++)
+        {
+            vsync.WaitForFrame(FRAME_INTERVAL);
+            AVSyncTelemetry::Sample sample;
+            sample.frame     = i;
+            sample.presented = VideoSync::GetTime();
+            sample.target    = vsync.GetNextTrigger();
+            telemetry.AddSample(sample);
+        }
+
+        QVector<AVSyncTelemetry::Sample> samples = telemetry.GetSamples();
+        QCOMPARE(samples.size(), FRAMES);
+
+        int64_t total = 0;
+        int64_t worst = 0;
+        for (int i = 0; i < samples.size(); i++)
+        {
+            QCOMPARE(samples[i].frame, (long long)i);
+            if (i)
+                QVERIFY(samples[i].presented >= samples[i - 1].presented);
+            QVERIFY(samples[i].presented >= samples[i].target);
+            int64_t late = samples[i].presented - samples[i].target;
+            total += late;
+            worst = max(worst, late);
+        }
+
+        qDebug("%d frames, lateness avg %lld us, max %lld us", FRAMES,
+               (long long)(total / FRAMES), (long long)worst);
+    }
+};
@@ -0,0 +1,3 @@
+#include "test_deinterlacers.h"
+
+QTEST_APPLESS_MAIN(TestDeinterlacers)
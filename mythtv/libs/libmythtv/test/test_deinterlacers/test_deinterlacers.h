@@ -0,0 +1,216 @@
+/*
+ *  Class TestDeinterlacers
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+
+#include "mythcorecontext.h"
+#include "mythdirs.h"
+#include "mythframe.h"
+#include "filtermanager.h"
+
+extern "C" {
+#include "libavutil/mem.h"
+}
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+#define MSKIP(MSG) QSKIP(MSG, SkipSingle)
+#else
+#define MSKIP(MSG) QSKIP(MSG)
+#endif
+
+#define WIDTH   1920
+#define HEIGHT  1080
+#define FRAMES  30
+
+/// A 1080i frame that owns its buffer.
+class TestFrame
+{
+  public:
+    TestFrame()
+    {
+        int size = buffersize(FMT_YV12, WIDTH, HEIGHT);
+        buf = (unsigned char*)av_malloc(size);
+        init(&frame, FMT_YV12, buf, WIDTH, HEIGHT, size);
+    }
+   ~TestFrame() { av_free(buf); }
+
+    /// Fills the frame with bars moving in opposite directions in the
+    /// two fields, on top of some noise.
+    void Fill(int number)
+    {
+        uint seed = number * 2654435761U;
+        for (int i = 0; i < 3; i++)
+        {
+            int w = i ? WIDTH / 2  : WIDTH;
+            int h = i ? HEIGHT / 2 : HEIGHT;
+            for (int y = 0; y < h; y++)
+            {
+                unsigned char *line =
+                    frame.buf + frame.offsets[i] + y * frame.pitches[i];
+                int shift = (y & 1) ? -number * 6 : number * 6;
+                for (int x = 0; x < frame.pitches[i]; x++)
+                {
+                    seed = seed * 1103515245 + 12345;
+                    int bar = (((x + shift + 4096) / 24) & 1) ? 180 : 50;
+                    line[x] = (x < w) ? bar + ((seed >> 16) & 31) : 0;
+                }
+            }
+        }
+        frame.frameNumber = number;
+    }
+
+    VideoFrame     frame;
+    unsigned char *buf;
+};
+
+class TestDeinterlacers: public QObject
+{
+    Q_OBJECT
+
+  private:
+    FilterChain *LoadChain(const QString &name, int threads)
+    {
+        VideoFrameType in  = FMT_YV12;
+        VideoFrameType out = FMT_YV12;
+        int width   = WIDTH;
+        int height  = HEIGHT;
+        int bufsize = 0;
+        return m_filterManager->LoadFilters(name, in, out, width, height,
+                                            bufsize, threads);
+    }
+
+    /// Runs one frame through the chain, twice for the double rate ones.
+    static void Deinterlace(FilterChain *chain, VideoFrame *frame,
+                            bool doublerate)
+    {
+        chain->ProcessFrame(frame, kScan_Interlaced);
+        if (doublerate)
+            chain->ProcessFrame(frame, kScan_Intr2ndField);
+    }
+
+    void AddFilterRows(void)
+    {
+        QTest::addColumn<QString>("filter");
+        QTest::newRow("linearblend")  << "linearblend";
+        QTest::newRow("kerneldeint")  << "kerneldeint";
+        QTest::newRow("kerneldoubleprocessdeint")
+                                      << "kerneldoubleprocessdeint";
+        QTest::newRow("yadifdeint")   << "yadifdeint";
+        QTest::newRow("yadifdoubleprocessdeint")
+                                      << "yadifdoubleprocessdeint";
+        QTest::newRow("greedyhdeint") << "greedyhdeint";
+    }
+
+    FilterManager *m_filterManager;
+
+  private slots:
+    // called at the beginning of these sets of tests
+    void initTestCase(void)
+    {
+        gCoreContext = new MythCoreContext("bin_version", NULL);
+        InitializeMythDirs();
+        m_filterManager = new FilterManager();
+    }
+
+    void cleanupTestCase(void)
+    {
+        delete m_filterManager;
+    }
+
+    void SlicedOutputIsIdentical_data(void)
+    {
+        AddFilterRows();
+    }
+
+    // Splitting a frame between threads must not change a single pixel.
+    void SlicedOutputIsIdentical(void)
+    {
+        QFETCH(QString, filter);
+
+        FilterChain *single = LoadChain(filter, 1);
+        FilterChain *sliced = LoadChain(filter, 4);
+        if (!single || !sliced)
+        {
+            delete single;
+            delete sliced;
+            MSKIP("Filter is not installed");
+        }
+
+        bool doublerate = filter.contains("doubleprocess");
+        TestFrame a, b;
+        for (int n = 0; n < 8; n++)
+        {
+            a.Fill(n);
+            b.Fill(n);
+            Deinterlace(single, &a.frame, doublerate);
+            Deinterlace(sliced, &b.frame, doublerate);
+            QVERIFY(!memcmp(a.buf, b.buf, a.frame.size));
+        }
+
+        delete single;
+        delete sliced;
+    }
+
+    void Throughput_data(void)
+    {
+        QTest::addColumn<QString>("filter");
+        QTest::addColumn<int>("threads");
+        QStringList names;
+        names << "linearblend" << "kerneldoubleprocessdeint"
+              << "yadifdeint" << "yadifdoubleprocessdeint" << "greedyhdeint";
+        foreach (const QString &name, names)
+        {
+            QTest::newRow(qPrintable(name + " 1 thread")) << name << 1;
+            QTest::newRow(qPrintable(name + " 4 threads")) << name << 4;
+        }
+    }
+
+    // Deinterlaces FRAMES 1080i frames and reports the frame rate.
+    void Throughput(void)
+    {
+        QFETCH(QString, filter);
+        QFETCH(int, threads);
+
+        FilterChain *chain = LoadChain(filter, threads);
+        if (!chain)
+            MSKIP("Filter is not installed");
+
+        bool doublerate = filter.contains("doubleprocess");
+        TestFrame frames[FRAMES];
+        for (int n = 0; n < FRAMES; n++)
+            frames[n].Fill(n);
+
+        QElapsedTimer timer;
+        qint64 nsecs  = 0;
+        int    passes = 0;
+        QBENCHMARK
+        {
+            timer.start();
+            for (int n = 0; n < FRAMES; n++)
+                Deinterlace(chain, &frames[n].frame, doublerate);
+            nsecs += timer.nsecsElapsed();
+            passes++;
+        }
+
+        qDebug("%s, %d threads: %.1f fps", qPrintable(filter), threads,
+               (double)FRAMES * passes * 1e9 / qMax(nsecs, (qint64)1));
+
+        delete chain;
+    }
+};
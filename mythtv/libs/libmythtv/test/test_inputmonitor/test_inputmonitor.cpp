@@ -0,0 +1,3 @@
+#include "test_inputmonitor.h"
+
+QTEST_APPLESS_MAIN(TestInputMonitor)
@@ -0,0 +1,264 @@
+/*
+ *  Class TestInputMonitor
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <unistd.h>
+
+#include <QtTest/QtTest>
+#include <QWaitCondition>
+#include <QMutex>
+#include <QSet>
+#include <QMap>
+
+#include "inputmonitor.h"
+#include "mythtimer.h"
+
+/// Generous, only reached when the monitor misbehaves
+#define WAIT_MS 10000
+
+/** Stands in for the capture devices.  Cards 10 and 11 share a device,
+ *  a card can be unplugged, or held in InitInput() to act like a tuner
+ *  that is slow to answer.
+ */
+class FakeInputs : public InputInitializer
+{
+  public:
+    FakeInputs() : m_rendezvous(0), m_inputsAdded(0) {}
+
+    QString GetDevice(uint cardid)
+    {
+        return QString("dev%1").arg(cardid / 10);
+    }
+
+    bool InitInput(uint cardid, bool create)
+    {
+        QMutexLocker locker(&m_lock);
+        m_inits.push_back(qMakePair(cardid, create));
+        QString device = GetDevice(cardid);
+        m_running[device]++;
+        m_maxRunning[device] = qMax(m_maxRunning[device], m_running[device]);
+
+        // Gives another init of the device the chance to overlap this one
+        locker.unlock();
+        usleep(20000);
+        locker.relock();
+
+        bool ok = !m_unplugged.contains(cardid);
+
+        // Waits until all the cards of a rendezvous are initializing
+        if (m_meet.contains(cardid))
+        {
+            m_rendezvous++;
+            m_wait.wakeAll();
+            MythTimer timer(MythTimer::kStartRunning);
+            while (m_rendezvous < m_meet.size() && timer.elapsed() < WAIT_MS)
+                m_wait.wait(&m_lock, WAIT_MS);
+            ok = ok && m_rendezvous >= m_meet.size();
+        }
+
+        while (m_blocked.contains(cardid))
+            m_wait.wait(&m_lock);
+
+        m_running[device]--;
+        return ok;
+    }
+
+    bool AddInput(uint cardid)
+    {
+        QMutexLocker locker(&m_lock);
+        if (m_refused.contains(cardid))
+            return false;
+        m_added.push_back(cardid);
+        return true;
+    }
+
+    void InputsAdded(uint count)
+    {
+        QMutexLocker locker(&m_lock);
+        m_inputsAdded += count;
+    }
+
+    void Unplug(uint cardid, bool unplug)
+    {
+        QMutexLocker locker(&m_lock);
+        if (unplug)
+            m_unplugged.insert(cardid);
+        else
+            m_unplugged.remove(cardid);
+    }
+
+    void Block(uint cardid, bool block)
+    {
+        QMutexLocker locker(&m_lock);
+        if (block)
+            m_blocked.insert(cardid);
+        else
+            m_blocked.remove(cardid);
+        m_wait.wakeAll();
+    }
+
+    QMutex                    m_lock;
+    QWaitCondition            m_wait;
+    QList<QPair<uint,bool> >  m_inits;
+    QMap<QString, int>        m_running;
+    QMap<QString, int>        m_maxRunning;
+    QSet<uint>                m_unplugged;
+    QSet<uint>                m_blocked;
+    QSet<uint>                m_refused;
+    QSet<uint>                m_meet;
+    int                       m_rendezvous;
+    QList<uint>               m_added;
+    uint                      m_inputsAdded;
+};
+
+class TestInputMonitor: public QObject
+{
+    Q_OBJECT
+
+    /// Waits for the card to be done initializing, either way
+    static bool WaitForInit(InputMonitor &monitor, uint cardid)
+    {
+        MythTimer timer(MythTimer::kStartRunning);
+        while (timer.elapsed() < WAIT_MS)
+        {
+            if (monitor.IsReady(cardid) || monitor.HasFailed(cardid))
+                return true;
+            usleep(1000);
+        }
+        return false;
+    }
+
+  private slots:
+    // Both cards have to be in InitInput() at the same time to succeed
+    void DevicesInitInParallel(void)
+    {
+        FakeInputs inputs;
+        inputs.m_meet << 10 << 20;
+
+        InputMonitor monitor(&inputs, 0, 0);
+        vector<uint> cardids;
+        cardids.push_back(10);
+        cardids.push_back(20);
+        monitor.InitInputs(cardids, 0);
+
+        QVERIFY(monitor.IsReady(10));
+        QVERIFY(monitor.IsReady(20));
+    }
+
+    void InputsOfOneDeviceInitInOrder(void)
+    {
+        FakeInputs inputs;
+        InputMonitor monitor(&inputs, 0, 0);
+        vector<uint> cardids;
+        cardids.push_back(10);
+        cardids.push_back(11);
+        monitor.InitInputs(cardids, 0);
+
+        QVERIFY(monitor.IsReady(10));
+        QVERIFY(monitor.IsReady(11));
+        QCOMPARE(inputs.m_maxRunning["dev1"], 1);
+        QCOMPARE(inputs.m_inits.size(), 2);
+        QCOMPARE(inputs.m_inits[0].first, 10U);
+        QCOMPARE(inputs.m_inits[1].first, 11U);
+        QVERIFY(!inputs.m_inits[0].second);
+    }
+
+    void SlowDeviceDoesNotBlock(void)
+    {
+        FakeInputs inputs;
+        inputs.Block(30, true);
+
+        InputMonitor monitor(&inputs, 0, 0);
+        vector<uint> cardids;
+        cardids.push_back(20);
+        cardids.push_back(30);
+        monitor.InitInputs(cardids, 100);
+
+        QVERIFY(monitor.IsReady(20));
+        QVERIFY(!monitor.IsReady(30));
+        QVERIFY(!monitor.HasFailed(30));
+
+        inputs.Block(30, false);
+        QVERIFY(WaitForInit(monitor, 30));
+        QVERIFY(monitor.IsReady(30));
+    }
+
+    // A device that is missing at startup and plugged in later
+    void HotPlug(void)
+    {
+        FakeInputs inputs;
+        inputs.Unplug(40, true);
+
+        InputMonitor monitor(&inputs, 0, 0);
+        vector<uint> cardids;
+        cardids.push_back(40);
+        monitor.InitInputs(cardids, 0);
+        QVERIFY(monitor.HasFailed(40));
+
+        monitor.Monitor(40);
+        monitor.CheckInputs();
+        QVERIFY(WaitForInit(monitor, 40));
+        QVERIFY(monitor.HasFailed(40));
+        QVERIFY(inputs.m_added.isEmpty());
+
+        inputs.Unplug(40, false);
+        monitor.CheckInputs();
+        QVERIFY(WaitForInit(monitor, 40));
+        QVERIFY(monitor.IsReady(40));
+
+        monitor.CheckInputs();
+        QCOMPARE(inputs.m_added.size(), 1);
+        QCOMPARE(inputs.m_added[0], 40U);
+        QCOMPARE(inputs.m_inputsAdded, 1U);
+
+        // Retries create the recorder again
+        QCOMPARE(inputs.m_inits.size(), 3);
+        QVERIFY(inputs.m_inits[1].second);
+        QVERIFY(inputs.m_inits[2].second);
+
+        // Added once only
+        monitor.CheckInputs();
+        QCOMPARE(inputs.m_inputsAdded, 1U);
+    }
+
+    // A card that initialized but couldn't be added is offered again
+    void AddInputFailureIsRetried(void)
+    {
+        FakeInputs inputs;
+        inputs.m_refused << 50;
+
+        InputMonitor monitor(&inputs, 0, 0);
+        vector<uint> cardids;
+        cardids.push_back(50);
+        monitor.InitInputs(cardids, 0);
+        monitor.Monitor(50);
+
+        monitor.CheckInputs();
+        QVERIFY(monitor.IsReady(50));
+        QVERIFY(inputs.m_added.isEmpty());
+
+        inputs.m_lock.lock();
+        inputs.m_refused.clear();
+        inputs.m_lock.unlock();
+        monitor.CheckInputs();
+        QCOMPARE(inputs.m_added.size(), 1);
+        QCOMPARE(inputs.m_inputsAdded, 1U);
+
+        // Not initialized again, the recorder is there already
+        QCOMPARE(inputs.m_inits.size(), 1);
+    }
+};
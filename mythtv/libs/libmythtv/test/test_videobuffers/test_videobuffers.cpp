@@ -0,0 +1,3 @@
+#include "test_videobuffers.h"
+
+QTEST_APPLESS_MAIN(TestVideoBuffers)
@@ -0,0 +1,189 @@
+/*
+ *  Class TestVideoBuffers
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+using namespace std;
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <QThread>
+
+#include "videobuffers.h"
+
+#define NUM_DECODE   16
+#define NUM_FRAMES   100000
+
+/// Hands frames to the display thread as fast as free frames allow.
+class DecoderThread : public QThread
+{
+  public:
+    DecoderThread(VideoBuffers &vbuffers, const QElapsedTimer &clock) :
+        m_vbuffers(vbuffers), m_clock(clock) {}
+
+  protected:
+    void run(void)
+    {
+        for (long long i = 0; i < NUM_FRAMES; i++)
+        {
+            while (!m_vbuffers.EnoughFreeFrames())
+                yieldCurrentThread();
+
+            VideoFrame *frame = m_vbuffers.GetNextFreeFrame();
+            frame->frameNumber = i;
+            frame->timecode    = m_clock.nsecsElapsed();
+            m_vbuffers.ReleaseFrame(frame);
+        }
+    }
+
+  private:
+    VideoBuffers        &m_vbuffers;
+    const QElapsedTimer &m_clock;
+};
+
+/// Takes frames off the used queue as soon as they show up, and keeps
+/// track of how long each one took to get there.
+class DisplayThread : public QThread
+{
+  public:
+    DisplayThread(VideoBuffers &vbuffers, const QElapsedTimer &clock) :
+        m_vbuffers(vbuffers), m_clock(clock),
+        m_shown(0), m_outOfOrder(0), m_totalLatency(0), m_maxLatency(0) {}
+
+    long long m_shown;
+    long long m_outOfOrder;
+    qint64    m_totalLatency; // nsecs
+    qint64    m_maxLatency;   // nsecs
+
+  protected:
+    void run(void)
+    {
+        while (m_shown < NUM_FRAMES)
+        {
+            if (!m_vbuffers.ValidVideoFrames())
+            {
+                yieldCurrentThread();
+                continue;
+            }
+
+            m_vbuffers.StartDisplayingFrame();
+            VideoFrame *frame = m_vbuffers.GetLastShownFrame();
+
+            qint64 latency = m_clock.nsecsElapsed() - frame->timecode;
+            m_totalLatency += latency;
+            m_maxLatency = max(m_maxLatency, latency);
+            if (frame->frameNumber != m_shown)
+                m_outOfOrder++;
+            m_shown++;
+
+            m_vbuffers.DoneDisplayingFrame(frame);
+        }
+    }
+
+  private:
+    VideoBuffers        &m_vbuffers;
+    const QElapsedTimer &m_clock;
+};
+
+class TestVideoBuffers: public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void init(void)
+    {
+        m_vbuffers.Init(NUM_DECODE, true, 1, 12, 4, 2);
+    }
+
+    void cleanup(void)
+    {
+        m_vbuffers.Reset();
+    }
+
+    void SizesFollowFrames(void)
+    {
+        QCOMPARE(m_vbuffers.FreeVideoFrames(), (uint)NUM_DECODE);
+        QCOMPARE(m_vbuffers.ValidVideoFrames(), 0U);
+
+        VideoFrame *frame = m_vbuffers.GetNextFreeFrame();
+        QVERIFY(frame);
+        QCOMPARE(m_vbuffers.FreeVideoFrames(), (uint)NUM_DECODE - 1);
+        QCOMPARE(m_vbuffers.Size(kVideoBuffer_limbo), 1U);
+
+        m_vbuffers.ReleaseFrame(frame);
+        QCOMPARE(m_vbuffers.ValidVideoFrames(), 1U);
+        QCOMPARE(m_vbuffers.Size(kVideoBuffer_limbo), 0U);
+
+        m_vbuffers.StartDisplayingFrame();
+        QCOMPARE(m_vbuffers.GetLastShownFrame(), frame);
+        m_vbuffers.DoneDisplayingFrame(frame);
+        QCOMPARE(m_vbuffers.ValidVideoFrames(), 0U);
+        QCOMPARE(m_vbuffers.FreeVideoFrames(), (uint)NUM_DECODE);
+    }
+
+    void SizesAfterDiscard(void)
+    {
+        for (uint i = 0; i < 4; i++)
+            m_vbuffers.ReleaseFrame(m_vbuffers.GetNextFreeFrame());
+        QCOMPARE(m_vbuffers.ValidVideoFrames(), 4U);
+
+        m_vbuffers.DiscardFrames(true);
+        QCOMPARE(m_vbuffers.ValidVideoFrames(), 0U);
+        QCOMPARE(m_vbuffers.FreeVideoFrames(), (uint)NUM_DECODE);
+    }
+
+    void SizesAfterBeginLock(void)
+    {
+        m_vbuffers.ReleaseFrame(m_vbuffers.GetNextFreeFrame());
+
+        frame_queue_t::iterator it = m_vbuffers.begin_lock(kVideoBuffer_used);
+        QVERIFY(it != m_vbuffers.end(kVideoBuffer_used));
+        m_vbuffers.DiscardFrame(*it);
+        m_vbuffers.end_lock();
+
+        QCOMPARE(m_vbuffers.ValidVideoFrames(), 0U);
+        QCOMPARE(m_vbuffers.FreeVideoFrames(), (uint)NUM_DECODE);
+    }
+
+    // Runs a decoder and a display thread flat out and reports how long
+    // a frame takes from ReleaseFrame() until the display picks it up.
+    void DecoderToDisplayHandoff(void)
+    {
+        QElapsedTimer clock;
+        clock.start();
+
+        DecoderThread decoder(m_vbuffers, clock);
+        DisplayThread display(m_vbuffers, clock);
+        display.start();
+        decoder.start();
+        QVERIFY(decoder.wait(60000));
+        QVERIFY(display.wait(60000));
+        qint64 elapsed = clock.elapsed();
+
+        QCOMPARE(display.m_shown, (long long)NUM_FRAMES);
+        QCOMPARE(display.m_outOfOrder, 0LL);
+        QCOMPARE(m_vbuffers.FreeVideoFrames(), (uint)NUM_DECODE);
+
+        qDebug("%d frames in %lld ms, handoff latency avg %lld us, "
+               "max %lld us", NUM_FRAMES, elapsed,
+               display.m_totalLatency / NUM_FRAMES / 1000,
+               display.m_maxLatency / 1000);
+    }
+
+  private:
+    VideoBuffers m_vbuffers;
+};
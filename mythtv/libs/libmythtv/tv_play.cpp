@@ -7577,6 +7577,7 @@ void TV::ChangeChannel(PlayerContext *ctx, ChannelChangeDirection direction)
     ctx->LockDeletePlayer(__FILE__, __LINE__);
     if (ctx->player)
     {
+        ctx->player->StartZapTimer();
         ctx->player->ResetCaptions();
         ctx->player->ResetTeletext();
     }
@@ -7762,6 +7763,7 @@ void TV::ChangeChannel(PlayerContext *ctx, uint chanid, const QString &chan)
     ctx->LockDeletePlayer(__FILE__, __LINE__);
     if (ctx->player)
     {
+        ctx->player->StartZapTimer();
         ctx->player->ResetCaptions();
         ctx->player->ResetTeletext();
     }
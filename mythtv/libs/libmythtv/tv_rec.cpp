@@ -1763,6 +1763,24 @@ QString TVRec::GetStartChannel(uint cardid, const QString &startinput)
 
 static void GetPidsToCache(DTVSignalMonitor *dtvMon, pid_cache_t &pid_cache)
 {
+    // Remember where the PMT of our program is, so the next tuning
+    // can listen for it without first waiting for the PAT.
+    MPEGStreamData *sd = dtvMon->GetStreamData();
+    if (sd && (dtvMon->GetProgramNumber() > 0))
+    {
+        pat_vec_t pats = sd->GetCachedPATs();
+        for (uint i = 0; i < pats.size(); ++i)
+        {
+            uint pmt_pid = pats[i]->FindPID(dtvMon->GetProgramNumber());
+            if (pmt_pid)
+            {
+                pid_cache.push_back(pid_cache_item_t(pmt_pid, TableID::PMT));
+                break;
+            }
+        }
+        sd->ReturnCachedPATTables(pats);
+    }
+
     if (!dtvMon->GetATSCStreamData())
         return;
 
@@ -1796,6 +1814,32 @@ static bool ApplyCachedPids(DTVSignalMonitor *dtvMon, const DTVChannel* channel)
     return vctpid_cached;
 }
 
+/** \brief Starts listening on the PMT PID seen the last time this channel
+ *         was tuned.
+ *
+ *   The PAT is still required for a lock, but the PMT no longer has
+ *   to wait for it, which saves a table repetition period per tuning.
+ *   If the PMT has moved the PAT will point the stream data at the new
+ *   PID as usual, and tables on the stale PID are ignored since they
+ *   don't carry our program number.
+ */
+static bool ApplyCachedPMTPid(DTVSignalMonitor *dtvMon,
+                              const DTVChannel *channel)
+{
+    pid_cache_t pid_cache;
+    channel->GetCachedPids(pid_cache);
+    pid_cache_t::const_iterator it = pid_cache.begin();
+    for (; it != pid_cache.end(); ++it)
+    {
+        if (it->GetTableID() == TableID::PMT)
+        {
+            dtvMon->GetStreamData()->AddListeningPID(it->GetPID());
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  *  \brief Tells DTVSignalMonitor what channel to look for.
  *
@@ -1903,6 +1947,7 @@ bool TVRec::SetupDTVSignalMonitor(bool EITscan)
                      SignalMonitor::kDTVSigMon_WaitForSDT |
                      SignalMonitor::kDVBSigMon_WaitForPos);
         sm->SetRotorTarget(1.0f);
+        ApplyCachedPMTPid(sm, dtvchan);
 
         if (EITscan)
         {
@@ -1940,6 +1985,7 @@ bool TVRec::SetupDTVSignalMonitor(bool EITscan)
                      SignalMonitor::kDTVSigMon_WaitForPMT |
                      SignalMonitor::kDVBSigMon_WaitForPos);
         sm->SetRotorTarget(1.0f);
+        ApplyCachedPMTPid(sm, dtvchan);
 
         if (EITscan)
         {
@@ -3523,6 +3569,7 @@ void TVRec::HandleTuning(void)
         TuningRequest request = tuningRequests.front();
         LOG(VB_RECORD, LOG_INFO, LOC +
             "HandleTuning Request: " + request.toString());
+        tuningTimer.start();
 
         QString input;
         request.channel = TuningGetChanNum(request, input);
@@ -3568,8 +3615,15 @@ void TVRec::HandleTuning(void)
     }
 
     MPEGStreamData *streamData = NULL;
-    if (HasFlags(kFlagWaitingForSignal) && !(streamData = TuningSignalCheck()))
-        return;
+    if (HasFlags(kFlagWaitingForSignal))
+    {
+        if (!(streamData = TuningSignalCheck()))
+            return;
+
+        LOG(VB_CHANNEL, LOG_INFO, LOC +
+            QString("HandleTuning: signal lock after %1 ms")
+                .arg(tuningTimer.elapsed()));
+    }
 
     if (HasFlags(kFlagNeedToStartRecorder))
     {
@@ -3578,6 +3632,10 @@ void TVRec::HandleTuning(void)
         else
             TuningNewRecorder(streamData);
 
+        LOG(VB_CHANNEL, LOG_INFO, LOC +
+            QString("HandleTuning: recorder started after %1 ms")
+                .arg(tuningTimer.elapsed()));
+
         // If we got this far it is safe to set a new starting channel...
         if (channel)
             channel->StoreInputChannels();
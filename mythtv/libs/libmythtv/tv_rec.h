@@ -335,6 +335,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     QDateTime         signalMonitorDeadline;
     uint              signalMonitorCheckCnt;
     bool              reachedRecordingDeadline;
+    /// Time since the current tuning request was taken off the queue
+    MythTimer         tuningTimer;
 
     // Various threads
     /// Event processing thread, runs TVRec::run().
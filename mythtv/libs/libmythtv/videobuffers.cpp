@@ -20,6 +20,29 @@ extern "C" {
 
 int next_dbg_str = 0;
 
+/** \class VideoBuffersLocker
+ *  Locks VideoBuffers::global_lock like a QMutexLocker, and publishes
+ *  the queue sizes before releasing it.  Used by every method that
+ *  moves frames between the queues.
+ */
+class VideoBuffersLocker
+{
+  public:
+    explicit VideoBuffersLocker(VideoBuffers *vbuffers) : m_vbuffers(vbuffers)
+    {
+        m_vbuffers->global_lock.lock();
+    }
+
+    ~VideoBuffersLocker()
+    {
+        m_vbuffers->UpdateCounts();
+        m_vbuffers->global_lock.unlock();
+    }
+
+  private:
+    VideoBuffers *m_vbuffers;
+};
+
 YUVInfo::YUVInfo(uint w, uint h, uint sz, const int *p, const int *o,
                  int aligned)
     : width(w), height(h), size(sz)
@@ -171,7 +194,7 @@ void VideoBuffers::Init(uint numdecode, bool extra_for_pause,
                         uint need_free, uint needprebuffer_normal,
                         uint needprebuffer_small, uint keepprebuffer)
 {
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
 
     Reset();
 
@@ -211,7 +234,7 @@ void VideoBuffers::Init(uint numdecode, bool extra_for_pause,
  */
 void VideoBuffers::Reset()
 {
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
 
     // Delete ffmpeg VideoFrames so we can create
     // a different number of buffers below
@@ -244,7 +267,7 @@ void VideoBuffers::SetPrebuffering(bool normal)
 
 VideoFrame *VideoBuffers::GetNextFreeFrameInternal(BufferType enqueue_to)
 {
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
     VideoFrame *frame = NULL;
 
     // Try to get a frame not being used by the decoder
@@ -316,7 +339,7 @@ VideoFrame *VideoBuffers::GetNextFreeFrame(BufferType enqueue_to)
  */
 void VideoBuffers::ReleaseFrame(VideoFrame *frame)
 {
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
 
     vpos = vbufferMap[frame];
     limbo.remove(frame);
@@ -333,7 +356,7 @@ void VideoBuffers::ReleaseFrame(VideoFrame *frame)
  */
 void VideoBuffers::DeLimboFrame(VideoFrame *frame)
 {
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
     if (limbo.contains(frame))
         limbo.remove(frame);
 
@@ -363,7 +386,7 @@ void VideoBuffers::StartDisplayingFrame(void)
  */
 void VideoBuffers::DoneDisplayingFrame(VideoFrame *frame)
 {
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
 
     if(used.contains(frame))
         Remove(kVideoBuffer_used, frame);
@@ -390,14 +413,12 @@ void VideoBuffers::DoneDisplayingFrame(VideoFrame *frame)
  */
 void VideoBuffers::DiscardFrame(VideoFrame *frame)
 {
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
     SafeEnqueue(kVideoBuffer_avail, frame);
 }
 
 frame_queue_t *VideoBuffers::Queue(BufferType type)
 {
-    QMutexLocker locker(&global_lock);
-
     frame_queue_t *q = NULL;
 
     if (type == kVideoBuffer_avail)
@@ -420,8 +441,6 @@ frame_queue_t *VideoBuffers::Queue(BufferType type)
 
 const frame_queue_t *VideoBuffers::Queue(BufferType type) const
 {
-    QMutexLocker locker(&global_lock);
-
     const frame_queue_t *q = NULL;
 
     if (type == kVideoBuffer_avail)
@@ -444,7 +463,7 @@ const frame_queue_t *VideoBuffers::Queue(BufferType type) const
 
 VideoFrame *VideoBuffers::Dequeue(BufferType type)
 {
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
 
     frame_queue_t *q = Queue(type);
 
@@ -489,16 +508,13 @@ void VideoBuffers::Enqueue(BufferType type, VideoFrame *frame)
     if (!frame)
         return;
 
+    VideoBuffersLocker locker(this);
     frame_queue_t *q = Queue(type);
     if (!q)
         return;
 
-    global_lock.lock();
     q->remove(frame);
     q->enqueue(frame);
-    global_lock.unlock();
-
-    return;
 }
 
 void VideoBuffers::Remove(BufferType type, VideoFrame *frame)
@@ -506,7 +522,7 @@ void VideoBuffers::Remove(BufferType type, VideoFrame *frame)
     if (!frame)
         return;
 
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
 
     if ((type & kVideoBuffer_avail) == kVideoBuffer_avail)
         available.remove(frame);
@@ -526,9 +542,10 @@ void VideoBuffers::Remove(BufferType type, VideoFrame *frame)
 
 void VideoBuffers::Requeue(BufferType dst, BufferType src, int num)
 {
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
 
-    num = (num <= 0) ? Size(src) : num;
+    const frame_queue_t *q = Queue(src);
+    num = (num <= 0) ? (q ? q->size() : 0) : num;
     for (uint i=0; i<(uint)num; i++)
     {
         VideoFrame *frame = Dequeue(src);
@@ -542,7 +559,7 @@ void VideoBuffers::SafeEnqueue(BufferType dst, VideoFrame* frame)
     if (!frame)
         return;
 
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
 
     Remove(kVideoBuffer_all, frame);
     Enqueue(dst, frame);
@@ -558,6 +575,13 @@ frame_queue_t::iterator VideoBuffers::begin_lock(BufferType type)
         return available.begin();
 }
 
+void VideoBuffers::end_lock(void)
+{
+    // the queues may have been changed while begin_lock() was held
+    UpdateCounts();
+    global_lock.unlock();
+}
+
 frame_queue_t::iterator VideoBuffers::end(BufferType type)
 {
     QMutexLocker locker(&global_lock);
@@ -572,8 +596,28 @@ frame_queue_t::iterator VideoBuffers::end(BufferType type)
     return it;
 }
 
+/**
+ * \fn VideoBuffers::Size(BufferType) const
+ *  Returns the number of frames in a queue.
+ *
+ *  The available and used queues are polled continuously by the
+ *  decoder and display threads, their sizes are read from the counts
+ *  published by UpdateCounts() without taking global_lock.
+ */
 uint VideoBuffers::Size(BufferType type) const
 {
+#if QT_VERSION >= 0x050000
+    if (type == kVideoBuffer_avail)
+        return availableCount.loadAcquire();
+    if (type == kVideoBuffer_used)
+        return usedCount.loadAcquire();
+#else
+    if (type == kVideoBuffer_avail)
+        return availableCount;
+    if (type == kVideoBuffer_used)
+        return usedCount;
+#endif
+
     QMutexLocker locker(&global_lock);
 
     const frame_queue_t *q = Queue(type);
@@ -583,6 +627,22 @@ uint VideoBuffers::Size(BufferType type) const
     return 0;
 }
 
+/**
+ * \fn VideoBuffers::UpdateCounts(void)
+ *  Publishes the sizes of the available and used queues.
+ *  Must be called with global_lock held, before it is released.
+ */
+void VideoBuffers::UpdateCounts(void)
+{
+#if QT_VERSION >= 0x050000
+    availableCount.storeRelease(available.size());
+    usedCount.storeRelease(used.size());
+#else
+    availableCount.fetchAndStoreRelease(available.size());
+    usedCount.fetchAndStoreRelease(used.size());
+#endif
+}
+
 bool VideoBuffers::Contains(BufferType type, VideoFrame *frame) const
 {
     QMutexLocker locker(&global_lock);
@@ -624,7 +684,7 @@ void VideoBuffers::SetLastShownFrameToScratch(void)
  */
 void VideoBuffers::DiscardFrames(bool next_frame_keyframe)
 {
-    QMutexLocker locker(&global_lock);
+    VideoBuffersLocker locker(this);
     LOG(VB_PLAYBACK, LOG_INFO, QString("VideoBuffers::DiscardFrames(%1): %2")
             .arg(next_frame_keyframe).arg(GetStatus()));
 
@@ -689,7 +749,7 @@ void VideoBuffers::DiscardFrames(bool next_frame_keyframe)
 void VideoBuffers::ClearAfterSeek(void)
 {
     {
-        QMutexLocker locker(&global_lock);
+        VideoBuffersLocker locker(this);
 
         for (uint i = 0; i < Size(); i++)
             At(i)->timecode = 0;
@@ -778,7 +838,7 @@ bool VideoBuffers::CreateBuffer(int width, int height, uint num, void* data,
 uint VideoBuffers::AddBuffer(int width, int height, void* data,
                              VideoFrameType fmt)
 {
-    QMutexLocker lock(&global_lock);
+    VideoBuffersLocker locker(this);
 
     uint num = Size();
     buffers.resize(num + 1);
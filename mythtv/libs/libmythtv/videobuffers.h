@@ -10,9 +10,11 @@ using namespace std;
 #include <QMutex>
 #include <QString>
 #include <QWaitCondition>
+#include <QAtomicInt>
 
 #include "mythframe.h"
 #include "mythdeque.h"
+#include "mythtvexp.h"
 
 #ifdef USING_X11
 class MythXDisplay;
@@ -57,7 +59,7 @@ class YUVInfo
     uint offsets[3];
 };
 
-class VideoBuffers
+class MTV_PUBLIC VideoBuffers
 {
   public:
     VideoBuffers();
@@ -96,7 +98,7 @@ class VideoBuffers
     void Remove(BufferType, VideoFrame *); // multiple buffer types ok
     frame_queue_t::iterator begin_lock(BufferType); // this locks VideoBuffer
     frame_queue_t::iterator end(BufferType);
-    void end_lock() { global_lock.unlock(); } // this unlocks VideoBuffer
+    void end_lock(); // this unlocks VideoBuffer
     uint Size(BufferType type) const;
     bool Contains(BufferType type, VideoFrame*) const;
 
@@ -129,9 +131,12 @@ class VideoBuffers
 
     QString GetStatus(int n=-1) const; // debugging method
   private:
+    friend class VideoBuffersLocker;
+
     frame_queue_t         *Queue(BufferType type);
     const frame_queue_t   *Queue(BufferType type) const;
     VideoFrame            *GetNextFreeFrameInternal(BufferType enqueue_to);
+    void                   UpdateCounts(void);
 
     frame_queue_t          available, used, limbo, pause, displayed, decode, finished;
     vbuffer_map_t          vbufferMap; // videobuffers to buffer's index
@@ -149,6 +154,11 @@ class VideoBuffers
     uint                   vpos;
 
     mutable QMutex         global_lock;
+
+    /// Sizes of the available and used queues, published whenever
+    /// global_lock is released so they can be polled without it.
+    QAtomicInt             availableCount;
+    QAtomicInt             usedCount;
 };
 
 #endif // __VIDEOBUFFERS_H__
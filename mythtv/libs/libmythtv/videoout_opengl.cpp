@@ -474,8 +474,17 @@ void VideoOutputOpenGL::ProcessFrame(VideoFrame *frame, OSD *osd,
     bool pauseframe = false;
     if (!frame)
     {
-        frame = vbuffers.GetScratchFrame();
-        CopyFrame(vbuffers.GetScratchFrame(), &av_pause_frame);
+        // The OSD is not drawn into the frame here, so the pause frame
+        // only needs a scratch copy when a filter will modify it.
+        if (filterList || (deint_proc && !IsBobDeint()))
+        {
+            frame = vbuffers.GetScratchFrame();
+            CopyFrame(frame, &av_pause_frame);
+        }
+        else
+        {
+            frame = &av_pause_frame;
+        }
         pauseframe = true;
     }
 
@@ -524,7 +533,9 @@ void VideoOutputOpenGL::PrepareFrame(VideoFrame *buffer, FrameScanType t,
 
     if (!buffer)
     {
-        buffer = vbuffers.GetScratchFrame();
+        // The scratch frame is only refreshed when the pause frame is
+        // filtered, the pause frame itself always has the right details.
+        buffer = &av_pause_frame;
         if (m_deinterlacing && !IsBobDeint())
             t = kScan_Interlaced;
     }
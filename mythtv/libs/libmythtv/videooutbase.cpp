@@ -1116,6 +1116,8 @@ void VideoOutput::ShowPIP(VideoFrame  *frame,
 
             sws_scale(pip_scaling_context, img_in.data, img_in.linesize, 0,
                       piph, img_out.data, img_out.linesize);
+            framecopy_count((uint64_t)pip_display_size.width() *
+                            pip_display_size.height() * 3 / 2);
 
             if (pipActive)
             {
@@ -1170,6 +1172,8 @@ void VideoOutput::ShowPIP(VideoFrame  *frame,
                        pip_tmp_image.pitches[p], pip_tmp_image.pitches[p]);
             }
         }
+        framecopy_count((uint64_t)pip_tmp_image.width *
+                        pip_tmp_image.height * 3 / 2);
     }
 
     // we're done with the frame, release it
@@ -1245,6 +1249,7 @@ void VideoOutput::ResizeVideo(VideoFrame *frame)
                        frame->width, frame->height);
         sws_scale(vsz_scale_context, img_in.data, img_in.linesize, 0,
                       frame->height, img_out.data, img_out.linesize);
+        framecopy_count((uint64_t)resize.width() * resize.height() * 3 / 2);
     }
 
     int xoff = resize.left();
@@ -1274,6 +1279,7 @@ void VideoOutput::ResizeVideo(VideoFrame *frame)
         memcpy(uptr + (i + yoff) * vidw + xoff, videouptr + i * resw, resw);
         memcpy(vptr + (i + yoff) * vidw + xoff, videovptr + i * resw, resw);
     }
+    framecopy_count((uint64_t)resize.width() * resize.height() * 3 / 2);
 }
 
 AspectOverrideMode VideoOutput::GetAspectOverride(void) const
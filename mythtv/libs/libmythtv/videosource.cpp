@@ -57,6 +57,7 @@ using namespace std;
 #endif
 
 static const uint kDefaultMultirecCount = 2;
+static const uint kMaxMultirecCount     = 10;
 
 VideoSourceSelector::VideoSourceSelector(uint           _initial_sourceid,
                                          const QString &_card_types,
@@ -125,7 +126,8 @@ void VideoSourceSelector::Load(void)
 class InstanceCount : public TransSpinBoxSetting
 {
   public:
-    InstanceCount(const CaptureCard &parent) : TransSpinBoxSetting(1, 5, 1)
+    InstanceCount(const CaptureCard &parent) :
+        TransSpinBoxSetting(1, kMaxMultirecCount, 1)
     {
         setLabel(QObject::tr("Max recordings"));
         setHelpText(
@@ -133,7 +135,11 @@ class InstanceCount : public TransSpinBoxSetting
                 "Maximum number of simultaneous recordings this device "
                 "should make. Some digital transmitters transmit multiple "
                 "programs on a multiplex, if this is set to a value greater "
-                "than one MythTV can sometimes take advantage of this."));
+                "than one MythTV can sometimes take advantage of this. "
+                "All recordings share one tuning, so programs on the same "
+                "multiplex do not conflict with each other, but each one "
+                "adds its own PID filters and some devices only support "
+                "a limited number of those."));
         uint cnt = parent.GetInstanceCount();
         cnt = (!cnt) ? kDefaultMultirecCount : cnt;
         setValue(cnt);
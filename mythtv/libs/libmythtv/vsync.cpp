@@ -121,11 +121,45 @@ VideoSync::VideoSync(VideoOutput *video_output,
 {
 }
 
+/** \fn VideoSync::GetTime(void)
+ *  \brief Returns the current time in microseconds.
+ *
+ *   On Linux this is the monotonic clock, so frame deadlines are not
+ *   disturbed when NTP steps the wall clock.  The value is only
+ *   meaningful relative to other GetTime(void) values.
+ */
 int64_t VideoSync::GetTime(void)
 {
+#ifdef __linux__
+    struct timespec now_ts;
+    clock_gettime(CLOCK_MONOTONIC, &now_ts);
+    return now_ts.tv_sec * 1000000LL + now_ts.tv_nsec / 1000;
+#else
     struct timeval now_tv;
     gettimeofday(&now_tv, NULL);
     return now_tv.tv_sec * 1000000LL + now_tv.tv_usec;
+#endif
+}
+
+/** \fn VideoSync::SleepUntil(int64_t)
+ *  \brief Sleeps until GetTime(void) reaches target.
+ *
+ *   On Linux the sleep is to an absolute time, so time lost to being
+ *   scheduled late or to computing the delay is not added on top.
+ */
+void VideoSync::SleepUntil(int64_t target)
+{
+#ifdef __linux__
+    struct timespec ts;
+    ts.tv_sec  = target / 1000000;
+    ts.tv_nsec = (target % 1000000) * 1000;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+#else
+    int64_t delay = target - GetTime();
+    if (delay > 0)
+        usleep(delay);
+#endif
 }
 
 void VideoSync::Start(void)
@@ -422,10 +456,10 @@ int BusyWaitVideoSync::WaitForFrame(int sync_delay)
     {
         int cnt = 0;
         m_cheat += 100;
-        // The usleep() is shortened by "cheat" so that this process gets
+        // The sleep is shortened by "cheat" so that this process gets
         // the CPU early for about half the frames.
         if (m_delay > (m_cheat - m_fudge))
-            usleep(m_delay - (m_cheat - m_fudge));
+            SleepUntil(m_nexttrigger - (m_cheat - m_fudge));
 
         // If late, draw the frame ASAP.  If early, hold the CPU until
         // half as late as the previous frame (fudge).
@@ -465,6 +499,6 @@ int USleepVideoSync::WaitForFrame(int sync_delay)
 
     m_delay = CalcDelay();
     if (m_delay > 0)
-        usleep(m_delay);
+        SleepUntil(m_nexttrigger);
     return 0;
 }
@@ -22,6 +22,8 @@
 #include <sys/time.h>
 #include <time.h>
 
+#include "mythtvexp.h"
+
 class VideoOutput;
 
 extern bool tryingVideoSync;
@@ -42,7 +44,7 @@ extern bool tryingVideoSync;
  *   than that, video timing is entirely up to these classes. When
  *   WaitForFrame returns, it is time to show the frame.
  */
-class VideoSync
+class MTV_PUBLIC VideoSync
 // virtual base class
 {
   public:
@@ -81,6 +83,9 @@ class VideoSync
 
     virtual void setFrameInterval(int fi) { m_frame_interval = fi; };
 
+    /// \brief Returns the time the last frame was due, see GetTime(void).
+    int64_t GetNextTrigger(void) const { return m_nexttrigger; }
+
     /** \brief Stops VSync; must be called from main thread.
      *
      *   Start(void), WaitForFrame(void), and Stop(void) should
@@ -93,8 +98,11 @@ class VideoSync
     static VideoSync *BestMethod(VideoOutput*,
                                  uint frame_interval, uint refresh_interval,
                                  bool interlaced);
+    // documented in vsync.cpp
+    static int64_t GetTime(void);
+
   protected:
-    int64_t GetTime(void);
+    void SleepUntil(int64_t target);
     int CalcDelay(void);
     void KeepPhase(void) MDEPRECATED;
 
@@ -190,15 +198,15 @@ class BusyWaitVideoSync : public VideoSync
 
 /** \brief Video synchronization classes employing only usleep().
  *
- *   Calls usleep() for the entire remaining frame interval.  Horribly
- *   inaccurate on < Linux 2.6 kernels; not very accurate there either.
- *   Not phase-maintaining. Not tried automatically.
+ *   Sleeps for the entire remaining frame interval.  On Linux this is
+ *   an absolute clock_nanosleep() to the frame's deadline, elsewhere a
+ *   usleep().  Not phase-maintaining. Not tried automatically.
  *
  *   This is only used when MythPlayer's 'disablevideo' is true (i.e. for
  *   commercial flagging and for transcoding), since it doesn't
  *   waste CPU cycles busy-waiting like BusyWaitVideoSync.
  */
-class USleepVideoSync : public VideoSync
+class MTV_PUBLIC USleepVideoSync : public VideoSync
 {
   public:
     USleepVideoSync(VideoOutput*,
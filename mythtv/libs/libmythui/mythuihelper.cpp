@@ -1,6 +1,7 @@
 #include "mythuihelper.h"
 
 #include <cmath>
+#include <cstring>
 
 #include <QImage>
 #include <QPixmap>
@@ -118,6 +119,13 @@ public:
     QAtomicInt m_cacheSize;
     QAtomicInt m_maxCacheSize;
 
+    // Counters reported by GetImageCacheStats()
+    QAtomicInt m_memoryHits;
+    QAtomicInt m_diskHits;
+    QAtomicInt m_decodes;
+    QAtomicInt m_decodeTime;
+    QAtomicInt m_maxDecodeTime;
+
     // The part of the screen(s) allocated for the GUI. Unless
     // overridden by the user, defaults to drawable area above.
     int m_screenxbase, m_screenybase;
@@ -160,6 +168,8 @@ MythUIHelperPrivate::MythUIHelperPrivate(MythUIHelper *p)
       m_baseWidth(800), m_baseHeight(600), m_isWide(false),
       m_cacheLock(new QMutex(QMutex::Recursive)),
       m_cacheSize(0), m_maxCacheSize(30 * 1024 * 1024),
+      m_memoryHits(0), m_diskHits(0), m_decodes(0), m_decodeTime(0),
+      m_maxDecodeTime(0),
       m_screenxbase(0), m_screenybase(0), m_screenwidth(0), m_screenheight(0),
       screensaver(NULL), screensaverEnabled(false), display_res(NULL),
       screenSetup(false), m_imageThreadPool(new MThreadPool("MythUIHelper")),
@@ -573,6 +583,139 @@ void MythUIHelper::ExcludeFromCacheSize(MythImage *im)
         d->m_cacheSize.fetchAndAddOrdered(-im->byteCount());
 }
 
+/**
+ *  \brief Records an image that had to be loaded from the original file,
+ *         which took \p msecs including scaling and effects.
+ */
+void MythUIHelper::AddImageDecode(uint msecs)
+{
+    int decodes = d->m_decodes.fetchAndAddOrdered(1) + 1;
+    d->m_decodeTime.fetchAndAddOrdered(msecs);
+
+    int max = d->m_maxDecodeTime.fetchAndAddOrdered(0);
+    while ((int)msecs > max &&
+           !d->m_maxDecodeTime.testAndSetOrdered(max, msecs))
+    {
+        max = d->m_maxDecodeTime.fetchAndAddOrdered(0);
+    }
+
+    if (decodes % 100 == 0 && VERBOSE_LEVEL_CHECK(VB_GUI, LOG_INFO))
+    {
+        ImageCacheStats stats = GetImageCacheStats();
+        uint total = stats.memoryHits + stats.diskHits + stats.decodes;
+        LOG(VB_GUI, LOG_INFO, LOC +
+            QString("Image cache: %1 lookups, %2% memory hits, "
+                    "%3% disk hits, %4 decodes avg %5 ms max %6 ms")
+            .arg(total)
+            .arg(stats.memoryHits * 100 / total)
+            .arg(stats.diskHits * 100 / total)
+            .arg(stats.decodes)
+            .arg(stats.decodeTime / stats.decodes)
+            .arg(stats.maxDecodeTime));
+    }
+}
+
+ImageCacheStats MythUIHelper::GetImageCacheStats(void)
+{
+    ImageCacheStats stats;
+    stats.memoryHits    = d->m_memoryHits.fetchAndAddOrdered(0);
+    stats.diskHits      = d->m_diskHits.fetchAndAddOrdered(0);
+    stats.decodes       = d->m_decodes.fetchAndAddOrdered(0);
+    stats.decodeTime    = d->m_decodeTime.fetchAndAddOrdered(0);
+    stats.maxDecodeTime = d->m_maxDecodeTime.fetchAndAddOrdered(0);
+    return stats;
+}
+
+/// Images up to this size are kept uncompressed in the disk cache.
+static const int kRawImageMaxBytes = 2 * 1024 * 1024;
+static const char kRawImageMagic[8] = "MYTHIMG";
+
+/// Prefix of an uncompressed image in the disk cache, followed by the
+/// scanlines exactly as QImage stores them.
+struct RawImageHeader
+{
+    char    magic[8];
+    quint32 width;
+    quint32 height;
+    quint32 format;
+    quint32 bytesPerLine;
+};
+
+/**
+ *  \brief Writes a scaled image uncompressed, so reading it back is a
+ *         single copy instead of a PNG decode.
+ *
+ *   Large images such as fanart would take too much space uncompressed,
+ *   they return false and are saved as PNG by the caller.
+ */
+static bool SaveRawImage(const QImage &image, const QString &filename)
+{
+    if (image.isNull() || image.byteCount() > kRawImageMaxBytes)
+        return false;
+
+    RawImageHeader header;
+    memcpy(header.magic, kRawImageMagic, sizeof(header.magic));
+    header.width        = image.width();
+    header.height       = image.height();
+    header.format       = image.format();
+    header.bytesPerLine = image.bytesPerLine();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    if (file.write((const char *)&header, sizeof(header)) != sizeof(header) ||
+        file.write((const char *)image.bits(), image.byteCount()) !=
+            image.byteCount())
+    {
+        file.close();
+        file.remove();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  \brief Loads an image written by SaveRawImage() through a memory
+ *         mapping, returns false for anything else (e.g. a PNG).
+ */
+static bool LoadRawImage(const QString &filename, MythImage *im)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly) ||
+        file.size() < (qint64)sizeof(RawImageHeader))
+        return false;
+
+    uchar *data = file.map(0, file.size());
+    if (!data)
+        return false;
+
+    RawImageHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    // The size check also rejects a file that is still being written
+    bool ok = !memcmp(header.magic, kRawImageMagic, sizeof(header.magic)) &&
+              header.format > QImage::Format_Invalid &&
+              header.format < QImage::NImageFormats &&
+              file.size() == (qint64)sizeof(header) +
+                             (qint64)header.bytesPerLine * header.height;
+
+    if (ok)
+    {
+        QImage mapped(data + sizeof(header), header.width, header.height,
+                      header.bytesPerLine, (QImage::Format)header.format);
+        // copy() detaches the image from the mapping before it goes away
+        im->Assign(mapped.copy());
+        im->SetFileName(filename);
+        ok = !im->isNull();
+    }
+
+    file.unmap(data);
+
+    return ok;
+}
+
 MythImage *MythUIHelper::CacheImage(const QString &url, MythImage *im,
                                     bool nodisk)
 {
@@ -594,7 +737,8 @@ MythImage *MythUIHelper::CacheImage(const QString &url, MythImage *im,
             themedir.mkdir(GetMythUI()->GetThemeCacheDir());
 
         // Save to disk cache
-        im->save(dstfile, "PNG");
+        if (!SaveRawImage(*im, dstfile))
+            im->save(dstfile, "PNG");
     }
 
     // delete the oldest cached images until we fall below threshold.
@@ -1527,6 +1671,8 @@ MythImage *MythUIHelper::LoadCacheImage(QString srcfile, QString label,
         if (d->imageCache.contains(label) &&
             d->CacheTrack[label] + kImageCacheTimeout > now)
         {
+            if (!(cacheMode & kCacheIgnoreDisk))
+                d->m_memoryHits.fetchAndAddOrdered(1);
             d->imageCache[label]->IncrRef();
             return d->imageCache[label];
         }
@@ -1536,6 +1682,7 @@ MythImage *MythUIHelper::LoadCacheImage(QString srcfile, QString label,
 
     // Check Memory Cache
     ret = GetImageFromCache(label);
+    bool inMemory = ret;
 
     // If the image is in the memory or we are not ignoring the disk cache
     // then proceed to check whether the source file is newer than our cached
@@ -1601,11 +1748,13 @@ MythImage *MythUIHelper::LoadCacheImage(QString srcfile, QString label,
                     ret = painter->GetFormatImage();
 
                     // Load file from disk cache to memory cache
-                    if (ret->Load(cachefilepath))
+                    if (LoadRawImage(cachefilepath, ret) ||
+                        ret->Load(cachefilepath))
                     {
                         // Add to ram cache, and skip saving to disk since that is
                         // where we found this in the first place.
                         CacheImage(label, ret, true);
+                        d->m_diskHits.fetchAndAddOrdered(1);
                     }
                     else
                     {
@@ -1629,6 +1778,11 @@ MythImage *MythUIHelper::LoadCacheImage(QString srcfile, QString label,
         }
     }
 
+    // MythUIImage::Load() checks the memory cache with kCacheIgnoreDisk
+    // before loading for real, only count the real lookup.
+    if (inMemory && ret && !(cacheMode & kCacheIgnoreDisk))
+        d->m_memoryHits.fetchAndAddOrdered(1);
+
     return ret;
 }
 
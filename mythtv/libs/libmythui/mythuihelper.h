@@ -39,6 +39,16 @@ struct MUI_PUBLIC MythUIMenuCallbacks
     void (*eject)(void);
 };
 
+/// Image cache counters, see MythUIHelper::GetImageCacheStats()
+struct ImageCacheStats
+{
+    uint memoryHits;  ///< found in the memory cache
+    uint diskHits;    ///< loaded from the scaled copy in the disk cache
+    uint decodes;     ///< loaded, scaled and processed from the original
+    uint decodeTime;  ///< total msecs spent in decodes
+    uint maxDecodeTime;
+};
+
 class MUI_PUBLIC MythUIHelper
 {
   public:
@@ -62,6 +72,9 @@ class MUI_PUBLIC MythUIHelper
     void IncludeInCacheSize(MythImage *im);
     void ExcludeFromCacheSize(MythImage *im);
 
+    void AddImageDecode(uint msecs);
+    ImageCacheStats GetImageCacheStats(void);
+
     Settings *qtconfig(void);
 
     bool IsScreenSetup(void);
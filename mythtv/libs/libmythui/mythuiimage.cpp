@@ -20,6 +20,7 @@
 
 // libmythbase
 #include "mythlogging.h"
+#include "mythtimer.h"
 
 // Mythui
 #include "mythpainter.h"
@@ -244,6 +245,8 @@ class ImageLoader
         bool bResize = false;
         bool bFoundInCache = false;
 
+        MythTimer decodeTimer;
+
         int w = -1;
         int h = -1;
 
@@ -290,6 +293,7 @@ class ImageLoader
                 QString("ImageLoader::LoadImage(%1) NOT Found in cache. "
                         "Loading Directly").arg(cacheKey));
 
+            decodeTimer.start();
             image = painter->GetFormatImage();
             bool ok = false;
 
@@ -371,6 +375,8 @@ class ImageLoader
 
             if (!imageReader)
                 GetMythUI()->CacheImage(cacheKey, image);
+
+            GetMythUI()->AddImageDecode(decodeTimer.elapsed());
         }
 
         if (image)
@@ -495,6 +501,21 @@ class ImageLoadThread : public QRunnable
         bool aborted = false;
         QString filename =  m_imageProperties.filename;
 
+        // When scrolling quickly the widget is often given another image
+        // while this one is still queued, skip the decode since the result
+        // would be thrown away by MythUIImage::customEvent() anyway.
+        m_parent->d->m_UpdateLock.lockForRead();
+        bool stale = (m_parent->m_imageProperties.filename != m_basefile);
+        m_parent->d->m_UpdateLock.unlock();
+
+        if (stale)
+        {
+            ImageLoadEvent *le = new ImageLoadEvent(m_parent, NULL, m_basefile,
+                                                    filename, m_number, true);
+            QCoreApplication::postEvent(const_cast<MythUIImage*>(m_parent), le);
+            return;
+        }
+
         // NOTE Do NOT use MythImageReader::supportsAnimation here, it defeats
         // the point of caching remote images
         if (ImageLoader::SupportsAnimation(filename))
@@ -1078,7 +1099,10 @@ bool MythUIImage::Load(bool allowLoadInBackground, bool forceStat)
                                              imProps,
                                              bFilename, i,
                                              static_cast<ImageCacheMode>(cacheMode2));
-            GetMythUI()->GetImageThreadPool()->start(bImgThread, "ImageLoad");
+            // Images on screen are decoded before those of hidden widgets,
+            // e.g. the next page of a list being prefetched.
+            GetMythUI()->GetImageThreadPool()->start(bImgThread, "ImageLoad",
+                                                     IsVisible(true) ? 0 : 1);
         }
         else
         {
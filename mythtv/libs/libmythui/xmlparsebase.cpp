@@ -7,6 +7,9 @@
 
 // QT headers
 #include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QMutex>
 #include <QDomDocument>
 #include <QString>
 #include <QBrush>
@@ -15,6 +18,7 @@
 
 // libmyth headers
 #include "mythlogging.h"
+#include "mythtimer.h"
 
 // Mythui headers
 #include "mythmainwindow.h"
@@ -323,6 +327,96 @@ QString XMLParseBase::parseText(QDomElement &element)
 static MythUIType *globalObjectStore = NULL;
 static QStringList loadedBaseFiles;
 
+/// Number of parsed theme files kept by LoadThemeDocument()
+static const int kMaxThemeDocuments = 16;
+
+struct ThemeDocument
+{
+    QDomDocument doc;
+    QDateTime    modified;
+    qint64       size;
+    uint         lastUsed;
+};
+
+static QMap<QString, ThemeDocument> themeDocuments;
+static uint themeDocumentsUsed = 0;
+/// Held while a cached document is walked, QDom isn't thread-safe.
+/// Recursive since a window may include further theme files.
+static QMutex themeDocumentsLock(QMutex::Recursive);
+
+/**
+ *  \brief Returns the parsed contents of a theme file.
+ *
+ *   The same few theme files are parsed again every time a screen is
+ *   opened, so the most recently used documents are kept in memory
+ *   until the file changes on disk or the theme is reloaded.  The
+ *   caller must hold themeDocumentsLock while using the document.
+ */
+static bool LoadThemeDocument(const QString &filename, QDomDocument &doc)
+{
+    QFileInfo fi(filename);
+    if (!fi.exists())
+        return false;
+
+    QMap<QString, ThemeDocument>::iterator it = themeDocuments.find(filename);
+    if (it != themeDocuments.end())
+    {
+        if ((*it).modified == fi.lastModified() && (*it).size == fi.size())
+        {
+            (*it).lastUsed = ++themeDocumentsUsed;
+            doc = (*it).doc;
+            return true;
+        }
+        themeDocuments.erase(it);
+    }
+
+    QFile f(filename);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+
+    MythTimer t;
+    t.start();
+
+    QString errorMsg;
+    int errorLine = 0;
+    int errorColumn = 0;
+
+    if (!doc.setContent(&f, false, &errorMsg, &errorLine, &errorColumn))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Location: '%1' @ %2 column: %3"
+                    "\n\t\t\tError: %4")
+                .arg(qPrintable(filename)).arg(errorLine).arg(errorColumn)
+                .arg(qPrintable(errorMsg)));
+        f.close();
+        return false;
+    }
+
+    f.close();
+
+    LOG(VB_GUI | VB_FILE, LOG_DEBUG, LOC +
+        QString("Parsed '%1' in %2 ms").arg(filename).arg(t.elapsed()));
+
+    if (themeDocuments.size() >= kMaxThemeDocuments)
+    {
+        QMap<QString, ThemeDocument>::iterator oldest = themeDocuments.begin();
+        for (it = themeDocuments.begin(); it != themeDocuments.end(); ++it)
+        {
+            if ((*it).lastUsed < (*oldest).lastUsed)
+                oldest = it;
+        }
+        themeDocuments.erase(oldest);
+    }
+
+    ThemeDocument &entry = themeDocuments[filename];
+    entry.doc      = doc;
+    entry.modified = fi.lastModified();
+    entry.size     = fi.size();
+    entry.lastUsed = ++themeDocumentsUsed;
+
+    return true;
+}
+
 MythUIType *XMLParseBase::GetGlobalObjectStore(void)
 {
     if (!globalObjectStore)
@@ -338,6 +432,9 @@ void XMLParseBase::ClearGlobalObjectStore(void)
 
     // clear any loaded base xml files which will force a reload the next time they are used
     loadedBaseFiles.clear();
+
+    QMutexLocker locker(&themeDocumentsLock);
+    themeDocuments.clear();
 }
 
 void XMLParseBase::ParseChildren(const QString &filename,
@@ -626,28 +723,11 @@ bool XMLParseBase::WindowExists(const QString &xmlfile,
     for (; it != searchpath.end(); ++it)
     {
         QString themefile = *it + xmlfile;
-        QFile f(themefile);
-
-        if (!f.open(QIODevice::ReadOnly))
-            continue;
+        QMutexLocker locker(&themeDocumentsLock);
 
         QDomDocument doc;
-        QString errorMsg;
-        int errorLine = 0;
-        int errorColumn = 0;
-
-        if (!doc.setContent(&f, false, &errorMsg, &errorLine, &errorColumn))
-        {
-            LOG(VB_GENERAL, LOG_ERR, LOC +
-                QString("Location: '%1' @ %2 column: %3"
-                        "\n\t\t\tError: %4")
-                    .arg(qPrintable(themefile)).arg(errorLine).arg(errorColumn)
-                    .arg(qPrintable(errorMsg)));
-            f.close();
+        if (!LoadThemeDocument(themefile, doc))
             continue;
-        }
-
-        f.close();
 
         QDomElement docElem = doc.documentElement();
         QDomNode n = docElem.firstChild();
@@ -677,6 +757,9 @@ bool XMLParseBase::LoadWindowFromXML(const QString &xmlfile,
     bool onlyLoadWindows = true;
     bool showWarnings = true;
 
+    MythTimer t;
+    t.start();
+
     const QStringList searchpath = GetMythUI()->GetThemeSearchPath();
     QStringList::const_iterator it = searchpath.begin();
     for (; it != searchpath.end(); ++it)
@@ -686,6 +769,8 @@ bool XMLParseBase::LoadWindowFromXML(const QString &xmlfile,
         if (doLoad(windowname, parent, themefile,
                    onlyLoadWindows, showWarnings))
         {
+            LOG(VB_GUI, LOG_INFO, LOC + QString("Window %1 built in %2 ms")
+                .arg(windowname).arg(t.elapsed()));
             return true;
         }
         else
@@ -707,28 +792,11 @@ bool XMLParseBase::doLoad(const QString &windowname,
                           bool onlywindows,
                           bool showWarnings)
 {
-    QDomDocument doc;
-    QFile f(filename);
+    QMutexLocker locker(&themeDocumentsLock);
 
-    if (!f.open(QIODevice::ReadOnly))
-        return false;
-
-    QString errorMsg;
-    int errorLine = 0;
-    int errorColumn = 0;
-
-    if (!doc.setContent(&f, false, &errorMsg, &errorLine, &errorColumn))
-    {
-        LOG(VB_GENERAL, LOG_ERR, LOC +
-            QString("Location: '%1' @ %2 column: %3"
-                    "\n\t\t\tError: %4")
-                .arg(qPrintable(filename)).arg(errorLine).arg(errorColumn)
-                .arg(qPrintable(errorMsg)));
-        f.close();
+    QDomDocument doc;
+    if (!LoadThemeDocument(filename, doc))
         return false;
-    }
-
-    f.close();
 
     QDomElement docElem = doc.documentElement();
     QDomNode n = docElem.firstChild();
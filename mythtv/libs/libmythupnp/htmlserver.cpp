@@ -78,9 +78,7 @@ bool HtmlServerExtension::ProcessRequest( HTTPRequest *pRequest )
 
         if (pRequest->m_sResourceUrl.startsWith("/StorageGroup/"))
         {
-            StorageGroup oGroup(pRequest->m_sResourceUrl.section('/', 2, 2));
-            QString      sFile =
-                oGroup.FindFile(pRequest->m_sResourceUrl.section('/', 3));
+            QString sFile = FindStorageGroupFile(pRequest->m_sResourceUrl);
             if (!sFile.isEmpty())
             {
                 oInfo.setFile(sFile);
@@ -144,6 +142,11 @@ bool HtmlServerExtension::ProcessRequest( HTTPRequest *pRequest )
 
                     pRequest->FormatFileResponse( sResName );
 
+                    // Live playlists change with every new segment
+                    if (sSuffix == "m3u8")
+                        pRequest->m_mapRespHeaders["Cache-Control"] =
+                            "no-cache";
+
                     return true;
                 }
             }
@@ -156,3 +159,40 @@ bool HtmlServerExtension::ProcessRequest( HTTPRequest *pRequest )
     return( true );
 }
 
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QString HtmlServerExtension::FindStorageGroupFile( const QString &sResourceUrl )
+{
+    {
+        QMutexLocker locker(&m_sgFileLock);
+
+        QHash<QString, QString>::const_iterator it =
+            m_sgFileCache.constFind(sResourceUrl);
+        if (it != m_sgFileCache.constEnd())
+        {
+            if (QFile::exists(*it))
+                return *it;
+
+            m_sgFileCache.remove(sResourceUrl);
+        }
+    }
+
+    // Constructing the StorageGroup queries the database, and FindFile()
+    // checks each of its directories in turn.
+    StorageGroup oGroup(sResourceUrl.section('/', 2, 2));
+    QString      sFile = oGroup.FindFile(sResourceUrl.section('/', 3));
+
+    if (!sFile.isEmpty())
+    {
+        QMutexLocker locker(&m_sgFileLock);
+
+        if (m_sgFileCache.size() >= 1024)
+            m_sgFileCache.clear();
+        m_sgFileCache[sResourceUrl] = sFile;
+    }
+
+    return sFile;
+}
@@ -13,6 +13,9 @@
 #ifndef __HTMLSERVER_H__
 #define __HTMLSERVER_H__
 
+#include <QHash>
+#include <QMutex>
+
 #include "httpserver.h"
 #include "serverSideScripting.h"
 
@@ -32,6 +35,13 @@ class UPNP_PUBLIC HtmlServerExtension : public HttpServerExtension
         ServerSideScripting m_Scripting;
         QString             m_IndexFilename;
 
+        // Storage Group file lookups, HTTP Live Stream clients request
+        // the same playlist and segment names over and over.
+        QMutex                  m_sgFileLock;
+        QHash<QString, QString> m_sgFileCache;
+
+        QString FindStorageGroupFile( const QString &sResourceUrl );
+
     public:
                  HtmlServerExtension( const QString &sSharePath,
                                       const QString &sApplicationPrefix);
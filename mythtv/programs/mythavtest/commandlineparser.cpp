@@ -31,21 +31,35 @@ void MythAVTestCommandLineParser::LoadArguments(void)
                     "be disabled and video will be displayed at the fastest possible rate. ")
                     ->SetGroup("Video Performance Testing")
                     ->SetRequiredChild("infile");
+    add(QStringList(QStringList() << "-b" << "--benchmark"), "benchmark", false,
+                    "Benchmark playback of one or more files without a display.",
+                    "Plays each file given with --infile or as an argument "
+                    "through the null video and audio outputs as fast as "
+                    "possible and reports frame rate, late frames, CPU time "
+                    "per thread and stage, and peak memory as JSON. "
+                    "Use --override-settings DefaultVideoPlaybackProfile=<name> "
+                    "to compare playback profiles. On X11 without a display "
+                    "run with QT_QPA_PLATFORM=offscreen.")
+                    ->SetGroup("Video Performance Testing");
+    add("--json", "json", "",
+                    "File to write the benchmark results to (default stdout).", "")
+                    ->SetGroup("Video Performance Testing")
+                    ->SetChildOf("benchmark");
     add(QStringList(QStringList() << "-d" << "--decodeonly"),
                     "decodeonly", false,
                     "Decode video frames but do not display them.",
                     "")
                     ->SetGroup("Video Performance Testing")
-                    ->SetChildOf("test");
+                    ->SetChildOf(QStringList() << "test" << "benchmark");
     add(QStringList(QStringList() << "--deinterlace"),
                     "deinterlace", false,
                     "Deinterlace video frames (even if progressive).",
                     "")
                     ->SetGroup("Video Performance Testing")
-                    ->SetChildOf("test");
+                    ->SetChildOf(QStringList() << "test" << "benchmark");
     add(QStringList(QStringList() << "-s" << "--seconds"), "seconds", "",
                     "The number of seconds to run the test (default 5).", "")
                     ->SetGroup("Video Performance Testing")
-                    ->SetChildOf("test");
+                    ->SetChildOf(QStringList() << "test" << "benchmark");
 }
 
@@ -1,4 +1,8 @@
 #include <unistd.h>
+#include <sys/time.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 #include <iostream>
 
 using namespace std;
@@ -8,6 +12,8 @@ using namespace std;
 #include <QDir>
 #include <QApplication>
 #include <QTime>
+#include <QFile>
+#include <QSize>
 
 #include "tv_play.h"
 #include "programinfo.h"
@@ -24,20 +30,77 @@ using namespace std;
 #include "mythlogging.h"
 #include "signalhandling.h"
 #include "mythmiscutil.h"
+#include "mythtimer.h"
+#include "mythconfig.h"
 
 // libmythui
 #include "mythuihelper.h"
 #include "mythmainwindow.h"
 
+static QString json_string(const QString &str)
+{
+    QString out = str;
+    out.replace("\\", "\\\\").replace("\"", "\\\"");
+    return "\"" + out + "\"";
+}
+
+#ifndef _WIN32
+static int64_t timeval_ms(const struct timeval &tv)
+{
+    return tv.tv_sec * 1000LL + tv.tv_usec / 1000;
+}
+#endif
+
+/// CPU time used by the calling thread, or the whole process, in ms.
+/// Returns 0 where this isn't available.
+static int64_t cpu_time_ms(bool thread)
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+#ifdef RUSAGE_THREAD
+    if (getrusage(thread ? RUSAGE_THREAD : RUSAGE_SELF, &usage) != 0)
+        return 0;
+#else
+    if (thread || getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#endif
+    return timeval_ms(usage.ru_utime) + timeval_ms(usage.ru_stime);
+#endif
+}
+
+static long peak_rss_kb(void)
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if CONFIG_DARWIN
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
 class VideoPerformanceTest
 {
   public:
     VideoPerformanceTest(const QString &filename, bool novsync, bool onlydecode,
-                         int runfor, bool deint)
+                         int runfor, bool deint, bool bench = false)
       : file(filename), novideosync(novsync), decodeonly(onlydecode),
-        secondstorun(runfor), deinterlace(deint), ctx(NULL)
+        secondstorun(runfor), deinterlace(deint), benchmark(bench),
+        ctx(NULL), ok(false), framesdecoded(0), framesshown(0),
+        lateframes(0), elapsed(0), cputotal(0), cpudisplay(0),
+        filterns(0), preparens(0), showns(0), waitns(0), peakrss(0)
     {
-        if (secondstorun < 1)
+        // A benchmark runs to the end of the file unless told otherwise
+        if (benchmark && secondstorun < 1)
+            secondstorun = 0;
+        else if (secondstorun < 1)
             secondstorun = 1;
         if (secondstorun > 3600)
             secondstorun = 3600;
@@ -55,15 +118,21 @@ class VideoPerformanceTest
         if (novideosync) // TODO
             LOG(VB_GENERAL, LOG_INFO, "Will attempt to disable sync-to-vblank.");
 
+        // The benchmark uses the null video output, so it measures the
+        // decoder and the software filters without a display.
+        PlayerFlags flags = kAudioMuted;
+        if (benchmark)
+            flags = (PlayerFlags)(flags | kVideoIsNull | kNoITV);
+
         RingBuffer *rb  = RingBuffer::Create(file, false, true, 2000);
-        MythPlayer  *mp  = new MythPlayer(kAudioMuted);
+        MythPlayer  *mp  = new MythPlayer(flags);
         mp->GetAudio()->SetAudioInfo("NULL", "NULL", 0, 0);
         mp->GetAudio()->SetNoAudio();
         ctx = new PlayerContext("VideoPerformanceTest");
         ctx->SetRingBuffer(rb);
         ctx->SetPlayer(mp);
         ctx->SetPlayingInfo(new ProgramInfo(file));
-        mp->SetPlayerInfo(NULL, GetMythMainWindow(), ctx);
+        mp->SetPlayerInfo(NULL, benchmark ? NULL : GetMythMainWindow(), ctx);
         FrameScanType scan = deinterlace ? kScan_Interlaced : kScan_Progressive;
         if (!mp->StartPlaying())
         {
@@ -81,8 +150,11 @@ class VideoPerformanceTest
         LOG(VB_GENERAL, LOG_INFO, "-----------------------------------");
         LOG(VB_GENERAL, LOG_INFO, QString("Starting video performance test for '%1'.")
             .arg(file));
-        LOG(VB_GENERAL, LOG_INFO, QString("Test will run for %1 seconds.")
-            .arg(secondstorun));
+        if (secondstorun)
+            LOG(VB_GENERAL, LOG_INFO, QString("Test will run for %1 seconds.")
+                .arg(secondstorun));
+        else
+            LOG(VB_GENERAL, LOG_INFO, "Test will run to the end of the file.");
 
         if (decodeonly)
             LOG(VB_GENERAL, LOG_INFO, "Decoding frames only - skipping display.");
@@ -91,12 +163,22 @@ class VideoPerformanceTest
 
         Jitterometer *jitter = new Jitterometer("Performance: ", mp->GetFrameRate());
 
-        int ms = secondstorun * 1000;
+        decodername = mp->GetDecoder() ? mp->GetDecoder()->GetCodecDecoderName()
+                                       : QString();
+        deinterlacer = vo->GetDeinterlacer();
+        videosize    = mp->GetVideoSize();
+        framerate    = mp->GetFrameRate();
+
+        int64_t cpustart     = cpu_time_ms(false);
+        int64_t displaystart = cpu_time_ms(true);
+        bool waited = false;
+        MythTimer stage;
         QTime start = QTime::currentTime();
+        ok = true;
         while (1)
         {
             int duration = start.msecsTo(QTime::currentTime());
-            if (duration < 0 || duration > ms)
+            if (duration < 0 || (secondstorun && duration > secondstorun * 1000))
             {
                 LOG(VB_GENERAL, LOG_INFO, "Complete.");
                 break;
@@ -105,6 +187,7 @@ class VideoPerformanceTest
             if (mp->IsErrored())
             {
                 LOG(VB_GENERAL, LOG_ERR, "Playback error.");
+                ok = false;
                 break;
             }
 
@@ -114,8 +197,17 @@ class VideoPerformanceTest
                 break;
             }
 
-            if (!mp->PrebufferEnoughFrames())
+            stage.start();
+            bool ready = mp->PrebufferEnoughFrames();
+            waitns += stage.nsecsElapsed();
+            if (!ready)
+            {
+                waited = true;
                 continue;
+            }
+            if (waited && framesshown)
+                lateframes++;
+            waited = false;
 
             mp->SetBuffering(false);
             vo->StartDisplayingFrame();
@@ -124,26 +216,156 @@ class VideoPerformanceTest
 
             if (!decodeonly)
             {
+                stage.start();
                 vo->ProcessFrame(frame, NULL, NULL, dummy, scan);
+                filterns += stage.nsecsElapsed();
+                stage.start();
                 vo->PrepareFrame(frame, scan, NULL);
+                preparens += stage.nsecsElapsed();
+                stage.start();
                 vo->Show(scan);
+                showns += stage.nsecsElapsed();
             }
             vo->DoneDisplayingFrame(frame);
-            jitter->RecordCycleTime();
+            framesshown++;
+            if (!benchmark)
+                jitter->RecordCycleTime();
+        }
+
+        elapsed       = start.msecsTo(QTime::currentTime());
+        cputotal      = cpu_time_ms(false) - cpustart;
+        cpudisplay    = cpu_time_ms(true) - displaystart;
+        peakrss       = peak_rss_kb();
+        if (mp->GetDecoder())
+            framesdecoded = mp->GetDecoder()->GetFramesPlayed();
+
+        if (benchmark)
+        {
+            LOG(VB_GENERAL, LOG_INFO,
+                QString("%1 frames in %2 ms, %3 fps, %4 late")
+                    .arg(framesshown).arg(elapsed)
+                    .arg(GetFPS(), 0, 'f', 2).arg(lateframes));
         }
         LOG(VB_GENERAL, LOG_INFO, "-----------------------------------");
         delete jitter;
     }
 
+    bool IsOK(void) const { return ok; }
+
+    double GetFPS(void) const
+    {
+        return elapsed ? framesshown * 1000.0 / elapsed : 0.0;
+    }
+
+    /// \brief Returns the results of the last Test() as a JSON object.
+    QString ToJSON(void) const
+    {
+        QStringList fields;
+        fields << QString("\"file\": %1").arg(json_string(file))
+               << QString("\"ok\": %1").arg(ok ? "true" : "false")
+               << QString("\"decoder\": %1").arg(json_string(decodername))
+               << QString("\"width\": %1").arg(videosize.width())
+               << QString("\"height\": %1").arg(videosize.height())
+               << QString("\"frame_rate\": %1").arg(framerate, 0, 'f', 3)
+               << QString("\"deinterlace\": %1")
+                      .arg(deinterlace ? "true" : "false")
+               << QString("\"deinterlacer\": %1").arg(json_string(deinterlacer))
+               << QString("\"decode_only\": %1")
+                      .arg(decodeonly ? "true" : "false")
+               << QString("\"frames_decoded\": %1").arg(framesdecoded)
+               << QString("\"frames_shown\": %1").arg(framesshown)
+               << QString("\"late_frames\": %1").arg(lateframes)
+               << QString("\"elapsed_ms\": %1").arg(elapsed)
+               << QString("\"fps\": %1").arg(GetFPS(), 0, 'f', 2)
+               << QString("\"cpu_ms\": { \"total\": %1, \"output_thread\": %2, "
+                          "\"other_threads\": %3 }")
+                      .arg(cputotal).arg(cpudisplay).arg(cputotal - cpudisplay)
+               << QString("\"stage_ms\": { \"wait\": %1, \"filter\": %2, "
+                          "\"prepare\": %3, \"show\": %4 }")
+                      .arg(waitns / 1000000.0, 0, 'f', 3)
+                      .arg(filterns / 1000000.0, 0, 'f', 3)
+                      .arg(preparens / 1000000.0, 0, 'f', 3)
+                      .arg(showns / 1000000.0, 0, 'f', 3)
+               << QString("\"peak_rss_kb\": %1").arg(peakrss);
+        return "{ " + fields.join(", ") + " }";
+    }
+
   private:
     QString file;
     bool    novideosync;
     bool    decodeonly;
     int     secondstorun;
     bool    deinterlace;
+    bool    benchmark;
     PlayerContext *ctx;
+
+    // Results
+    bool      ok;
+    QString   decodername;
+    QString   deinterlacer;
+    QSize     videosize;
+    double    framerate;
+    long long framesdecoded;
+    long long framesshown;
+    long long lateframes;   ///< frames the output had to wait for
+    int       elapsed;      // ms
+    int64_t   cputotal;     // ms, all threads
+    int64_t   cpudisplay;   // ms, the thread running the output loop
+    int64_t   filterns;     ///< stage times are in ns, reported in ms
+    int64_t   preparens;
+    int64_t   showns;
+    int64_t   waitns;       ///< time spent waiting for decoded frames
+    long      peakrss;
 };
 
+/** \brief Plays every file through the null video output as fast as
+ *         possible and writes the results as JSON.
+ */
+static int RunBenchmark(const QStringList &files, const MythAVTestCommandLineParser &cmdline)
+{
+    int seconds = 0;
+    if (!cmdline.toString("seconds").isEmpty())
+        seconds = cmdline.toInt("seconds");
+
+    QStringList results;
+    bool ok = true;
+    foreach (const QString &file, files)
+    {
+        VideoPerformanceTest test(file, false, cmdline.toBool("decodeonly"),
+                                  seconds, cmdline.toBool("deinterlace"),
+                                  true);
+        test.Test();
+        results << "    " + test.ToJSON();
+        ok &= test.IsOK();
+    }
+
+    QString profile = gCoreContext->GetSetting("DefaultVideoPlaybackProfile");
+    QString json = QString("{\n  \"version\": %1,\n  \"profile\": %2,\n"
+                           "  \"clips\": [\n%3\n  ]\n}\n")
+        .arg(json_string(GetMythSourceVersion()))
+        .arg(json_string(profile))
+        .arg(results.join(",\n"));
+
+    QString output = cmdline.toString("json");
+    if (output.isEmpty() || output == "-")
+    {
+        cout << json.toLocal8Bit().constData();
+    }
+    else
+    {
+        QFile file(output);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+            file.write(json.toUtf8()) < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR,
+                QString("Unable to write results to '%1'").arg(output));
+            return GENERIC_EXIT_NOT_OK;
+        }
+    }
+
+    return ok ? GENERIC_EXIT_OK : GENERIC_EXIT_NOT_OK;
+}
+
 int main(int argc, char *argv[])
 {
     MythAVTestCommandLineParser cmdline;
@@ -188,6 +410,8 @@ int main(int argc, char *argv[])
     else if (cmdline.GetArgs().size() >= 1)
         filename = cmdline.GetArgs()[0];
 
+    bool benchmark = cmdline.toBool("benchmark");
+
     gContext = new MythContext(MYTH_BINARY_VERSION);
     if (!gContext->Init())
     {
@@ -203,6 +427,22 @@ int main(int argc, char *argv[])
         return GENERIC_EXIT_NOT_OK;
     }
 
+    if (benchmark)
+    {
+        QStringList files = cmdline.GetArgs();
+        if (!cmdline.toString("infile").isEmpty())
+            files.prepend(cmdline.toString("infile"));
+        if (files.isEmpty())
+        {
+            LOG(VB_GENERAL, LOG_ERR, "No files given to benchmark.");
+            return GENERIC_EXIT_INVALID_CMDLINE;
+        }
+
+        retval = RunBenchmark(files, cmdline);
+        delete gContext;
+        return retval;
+    }
+
     QString themename = gCoreContext->GetSetting("Theme");
     QString themedir = GetMythUI()->FindThemeDir(themename);
     if (themedir.isEmpty())
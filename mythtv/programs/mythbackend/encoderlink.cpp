@@ -41,7 +41,7 @@ using namespace std;
 EncoderLink::EncoderLink(int capturecardnum, PlaybackSock *lsock,
                          QString lhostname)
     : m_capturecardnum(capturecardnum), sock(lsock), hostname(lhostname),
-      tv(NULL), local(false), locked(false),
+      tv(NULL), local(0), locked(false),
       sleepStatus(sStatus_Undefined), chanid(0)
 {
     endRecordingTime = MythDate::current().addDays(-2);
@@ -59,7 +59,7 @@ EncoderLink::EncoderLink(int capturecardnum, PlaybackSock *lsock,
  */
 EncoderLink::EncoderLink(int capturecardnum, TVRec *ltv)
     : m_capturecardnum(capturecardnum), sock(NULL),
-      tv(ltv), local(true), locked(false),
+      tv(ltv), local(1), locked(false),
       sleepStatus(sStatus_Undefined), chanid(0)
 {
     endRecordingTime = MythDate::current().addDays(-2);
@@ -70,6 +70,27 @@ EncoderLink::EncoderLink(int capturecardnum, TVRec *ltv)
     lastWakeTime    = MythDate::current();
 }
 
+/** \brief Turns a non-local EncoderLink without a socket into a local
+ *         one, used when a local card's device shows up after startup.
+ *
+ *   The Scheduler and MainServer threads use the link meanwhile without
+ *   a lock.  Until the switch they see a non-local link without a socket
+ *   and every call fails as for a slave that is down.  tv is written
+ *   first and then local is set with release semantics, and IsLocal()
+ *   reads it with acquire semantics, so a thread that sees the link as
+ *   local also sees the TVRec.  Every local path checks IsLocal() before
+ *   it touches tv.  This may only be called once per link.
+ */
+void EncoderLink::SetTVRec(TVRec *ltv)
+{
+    tv = ltv;
+#if QT_VERSION >= 0x050000
+    local.storeRelease(1);
+#else
+    local.fetchAndStoreRelease(1);
+#endif
+}
+
 /** \fn EncoderLink::~EncoderLink()
  *  \brief Destructor does nothing for non-local EncoderLink instances,
  *         but deletes the TVRec for local EncoderLink instances.
@@ -156,7 +177,7 @@ void EncoderLink::SetSleepStatus(SleepStatus newStatus)
  */
 bool EncoderLink::IsBusy(InputInfo *busy_input, int time_buffer)
 {
-    if (local)
+    if (IsLocal())
         return tv->IsBusy(busy_input, time_buffer);
 
     if (HasSockAndIncrRef())
@@ -202,7 +223,7 @@ TVState EncoderLink::GetState(void)
     if (!IsConnected())
         return retval;
 
-    if (local)
+    if (IsLocal())
         retval = tv->GetState();
     else if (HasSockAndIncrRef())
     {
@@ -227,7 +248,7 @@ uint EncoderLink::GetFlags(void)
     if (!IsConnected())
         return retval;
 
-    if (local)
+    if (IsLocal())
         retval = tv->GetFlags();
     else if (HasSockAndIncrRef())
     {
@@ -264,7 +285,7 @@ bool EncoderLink::MatchesRecording(const ProgramInfo *rec)
     bool retval = false;
     ProgramInfo *tvrec = NULL;
 
-    if (local)
+    if (IsLocal())
     {
         while (kState_ChangingState == GetState())
             usleep(100);
@@ -301,7 +322,7 @@ bool EncoderLink::MatchesRecording(const ProgramInfo *rec)
 void EncoderLink::RecordPending(const ProgramInfo *rec, int secsleft,
                                 bool hasLater)
 {
-    if (local)
+    if (IsLocal())
         tv->RecordPending(rec, secsleft, hasLater);
     else if (HasSockAndIncrRef())
     {
@@ -361,7 +382,7 @@ void EncoderLink::GetDiskSpace(QStringList &o_strlist)
  */
 long long EncoderLink::GetMaxBitrate()
 {
-    if (local)
+    if (IsLocal())
         return tv->GetMaxBitrate();
     else if (HasSockAndIncrRef())
     {
@@ -388,7 +409,7 @@ long long EncoderLink::GetMaxBitrate()
  */
 int EncoderLink::SetSignalMonitoringRate(int rate, int notifyFrontend)
 {
-    if (local)
+    if (IsLocal())
         return tv->SetSignalMonitoringRate(rate, notifyFrontend);
     else if (HasSockAndIncrRef())
     {
@@ -440,7 +461,7 @@ RecStatusType EncoderLink::StartRecording(ProgramInfo *rec)
     startRecordingTime = rec->GetRecordingStartTime();
     chanid = rec->GetChanID();
 
-    if (local)
+    if (IsLocal())
         retval = tv->StartRecording(rec);
     else if (HasSockAndIncrRef())
     {
@@ -467,7 +488,7 @@ RecStatusType EncoderLink::GetRecordingStatus(void)
 {
     RecStatusType retval = rsAborted;
 
-    if (local)
+    if (IsLocal())
         retval = tv->GetRecordingStatus();
     else if (HasSockAndIncrRef())
     {
@@ -500,7 +521,7 @@ ProgramInfo *EncoderLink::GetRecording(void)
 {
     ProgramInfo *info = NULL;
 
-    if (local)
+    if (IsLocal())
         info = tv->GetRecording();
     else if (HasSockAndIncrRef())
     {
@@ -522,7 +543,7 @@ void EncoderLink::StopRecording(bool killFile)
     startRecordingTime = endRecordingTime;
     chanid = 0;
 
-    if (local)
+    if (IsLocal())
     {
         tv->StopRecording(killFile);
         return;
@@ -536,7 +557,7 @@ void EncoderLink::StopRecording(bool killFile)
  */
 void EncoderLink::FinishRecording(void)
 {
-    if (local)
+    if (IsLocal())
     {
         tv->FinishRecording();
         return;
@@ -554,7 +575,7 @@ void EncoderLink::FinishRecording(void)
  */
 bool EncoderLink::IsReallyRecording(void)
 {
-    if (local)
+    if (IsLocal())
         return tv->IsReallyRecording();
 
     LOG(VB_GENERAL, LOG_ERR, "Should be local only query: IsReallyRecording");
@@ -570,7 +591,7 @@ bool EncoderLink::IsReallyRecording(void)
  */
 float EncoderLink::GetFramerate(void)
 {
-    if (local)
+    if (IsLocal())
         return tv->GetFramerate();
 
     LOG(VB_GENERAL, LOG_ERR, "Should be local only query: GetFramerate");
@@ -586,7 +607,7 @@ float EncoderLink::GetFramerate(void)
  */
 long long EncoderLink::GetFramesWritten(void)
 {
-    if (local)
+    if (IsLocal())
         return tv->GetFramesWritten();
 
     LOG(VB_GENERAL, LOG_ERR, "Should be local only query: GetFramesWritten");
@@ -601,7 +622,7 @@ long long EncoderLink::GetFramesWritten(void)
  */
 long long EncoderLink::GetFilePosition(void)
 {
-    if (local)
+    if (IsLocal())
         return tv->GetFilePosition();
 
     LOG(VB_GENERAL, LOG_ERR, "Should be local only query: GetFilePosition");
@@ -616,7 +637,7 @@ long long EncoderLink::GetFilePosition(void)
  */
 int64_t EncoderLink::GetKeyframePosition(uint64_t desired)
 {
-    if (local)
+    if (IsLocal())
         return tv->GetKeyframePosition(desired);
 
     LOG(VB_GENERAL, LOG_ERR, "Should be local only query: GetKeyframePosition");
@@ -626,7 +647,7 @@ int64_t EncoderLink::GetKeyframePosition(uint64_t desired)
 bool EncoderLink::GetKeyframePositions(
     int64_t start, int64_t end, frm_pos_map_t &map)
 {
-    if (!local)
+    if (!IsLocal())
     {
         LOG(VB_GENERAL, LOG_ERR,
             "Should be local only query: GetKeyframePositions");
@@ -639,7 +660,7 @@ bool EncoderLink::GetKeyframePositions(
 bool EncoderLink::GetKeyframeDurations(
     int64_t start, int64_t end, frm_pos_map_t &map)
 {
-    if (!local)
+    if (!IsLocal())
     {
         LOG(VB_GENERAL, LOG_ERR,
             "Should be local only query: GetKeyframeDurations");
@@ -656,7 +677,7 @@ bool EncoderLink::GetKeyframeDurations(
  */
 void EncoderLink::FrontendReady(void)
 {
-    if (local)
+    if (IsLocal())
         tv->FrontendReady();
     else
         LOG(VB_GENERAL, LOG_ERR, "Should be local only query: FrontendReady");
@@ -672,7 +693,7 @@ void EncoderLink::FrontendReady(void)
  */
 void EncoderLink::CancelNextRecording(bool cancel)
 {
-    if (local)
+    if (IsLocal())
         tv->CancelNextRecording(cancel);
     else if (HasSockAndIncrRef())
     {
@@ -694,7 +715,7 @@ void EncoderLink::CancelNextRecording(bool cancel)
  */
 void EncoderLink::SpawnLiveTV(LiveTVChain *chain, bool pip, QString startchan)
 {
-    if (local)
+    if (IsLocal())
         tv->SpawnLiveTV(chain, pip, startchan);
     else
         LOG(VB_GENERAL, LOG_ERR, "Should be local only query: SpawnLiveTV");
@@ -705,7 +726,7 @@ void EncoderLink::SpawnLiveTV(LiveTVChain *chain, bool pip, QString startchan)
  */
 QString EncoderLink::GetChainID(void)
 {
-    if (local)
+    if (IsLocal())
         return tv->GetChainID();
 
     LOG(VB_GENERAL, LOG_ERR, "Should be local only query: SpawnLiveTV");
@@ -719,7 +740,7 @@ QString EncoderLink::GetChainID(void)
  */
 void EncoderLink::StopLiveTV(void)
 {
-    if (local)
+    if (IsLocal())
         tv->StopLiveTV();
     else
         LOG(VB_GENERAL, LOG_ERR, "Should be local only query: StopLiveTV");
@@ -733,7 +754,7 @@ void EncoderLink::StopLiveTV(void)
  */
 void EncoderLink::PauseRecorder(void)
 {
-    if (local)
+    if (IsLocal())
         tv->PauseRecorder();
     else
         LOG(VB_GENERAL, LOG_ERR, "Should be local only query: PauseRecorder");
@@ -746,7 +767,7 @@ void EncoderLink::PauseRecorder(void)
  */
 void EncoderLink::SetLiveRecording(int recording)
 {
-    if (local)
+    if (IsLocal())
         tv->SetLiveRecording(recording);
     else
         LOG(VB_GENERAL, LOG_ERR,
@@ -758,7 +779,7 @@ void EncoderLink::SetLiveRecording(int recording)
  */
 void EncoderLink::SetNextLiveTVDir(QString dir)
 {
-    if (local)
+    if (IsLocal())
         tv->SetNextLiveTVDir(dir);
     else if (HasSockAndIncrRef())
     {
@@ -777,7 +798,7 @@ vector<InputInfo> EncoderLink::GetFreeInputs(
 {
     vector<InputInfo> list;
 
-    if (local)
+    if (IsLocal())
         list = tv->GetFreeInputs(excluded_cardids);
     else if (HasSockAndIncrRef())
     {
@@ -796,7 +817,7 @@ vector<InputInfo> EncoderLink::GetFreeInputs(
  */
 QString EncoderLink::GetInput(void) const
 {
-    if (local)
+    if (IsLocal())
         return tv->GetInput();
 
     LOG(VB_GENERAL, LOG_ERR, "Should be local only query: GetInput");
@@ -815,7 +836,7 @@ QString EncoderLink::GetInput(void) const
  */
 QString EncoderLink::SetInput(QString input)
 {
-    if (local)
+    if (IsLocal())
         return tv->SetInput(input);
 
     LOG(VB_GENERAL, LOG_ERR, "Should be local only query: SetInput");
@@ -829,7 +850,7 @@ QString EncoderLink::SetInput(QString input)
  */
 void EncoderLink::ToggleChannelFavorite(QString changroup)
 {
-    if (local)
+    if (IsLocal())
         tv->ToggleChannelFavorite(changroup);
     else
         LOG(VB_GENERAL, LOG_ERR,
@@ -844,7 +865,7 @@ void EncoderLink::ToggleChannelFavorite(QString changroup)
  */
 void EncoderLink::ChangeChannel(ChannelChangeDirection channeldirection)
 {
-    if (local)
+    if (IsLocal())
         tv->ChangeChannel(channeldirection);
     else
         LOG(VB_GENERAL, LOG_ERR, "Should be local only query: ChangeChannel");
@@ -859,7 +880,7 @@ void EncoderLink::ChangeChannel(ChannelChangeDirection channeldirection)
  */
 void EncoderLink::SetChannel(const QString &name)
 {
-    if (local)
+    if (IsLocal())
         tv->SetChannel(name);
     else
         LOG(VB_GENERAL, LOG_ERR, "Should be local only query: SetChannel");
@@ -875,7 +896,7 @@ void EncoderLink::SetChannel(const QString &name)
  */
 int EncoderLink::GetPictureAttribute(PictureAttribute attr)
 {
-    if (!local)
+    if (!IsLocal())
     {
         LOG(VB_GENERAL, LOG_ERR,
             "Should be local only query: GetPictureAttribute");
@@ -897,7 +918,7 @@ int EncoderLink::ChangePictureAttribute(PictureAdjustType type,
                                         PictureAttribute  attr,
                                         bool              direction)
 {
-    if (!local)
+    if (!IsLocal())
     {
         LOG(VB_GENERAL, LOG_ERR,
             "Should be local only query: ChangePictureAttribute");
@@ -918,7 +939,7 @@ int EncoderLink::ChangePictureAttribute(PictureAdjustType type,
  */
 bool EncoderLink::CheckChannel(const QString &name)
 {
-    if (local)
+    if (IsLocal())
         return tv->CheckChannel(name);
 
     LOG(VB_GENERAL, LOG_ERR, "Should be local only query: CheckChannel");
@@ -936,7 +957,7 @@ bool EncoderLink::CheckChannel(const QString &name)
  */
 bool EncoderLink::ShouldSwitchToAnotherCard(const QString &channelid)
 {
-    if (local)
+    if (IsLocal())
         return tv->ShouldSwitchToAnotherCard(channelid);
 
     LOG(VB_GENERAL, LOG_ERR,
@@ -957,7 +978,7 @@ bool EncoderLink::CheckChannelPrefix(
     bool          &is_extra_char_useful,
     QString       &needed_spacer)
 {
-    if (local)
+    if (IsLocal())
     {
         return tv->CheckChannelPrefix(
             prefix, is_complete_valid_channel_on_rec,
@@ -984,7 +1005,7 @@ void EncoderLink::GetNextProgram(BrowseDirection direction,
                                  QString &channelname, uint    &_chanid,
                                  QString &seriesid,    QString &programid)
 {
-    if (local)
+    if (IsLocal())
     {
         tv->GetNextProgram(direction,
                            title, subtitle, desc, category, starttime,
@@ -999,7 +1020,7 @@ bool EncoderLink::GetChannelInfo(uint &chanid, uint &sourceid,
                                  QString &callsign, QString &channum,
                                  QString &channame, QString &xmltv) const
 {
-    if (!local)
+    if (!IsLocal())
     {
         LOG(VB_GENERAL, LOG_ERR, "Should be local only query: GetChannelInfo");
         return false;
@@ -1014,7 +1035,7 @@ bool EncoderLink::SetChannelInfo(uint chanid, uint sourceid,
                                  QString callsign, QString channum,
                                  QString channame, QString xmltv)
 {
-    if (!local)
+    if (!IsLocal())
     {
         LOG(VB_GENERAL, LOG_ERR, "Should be local only query: SetChannelInfo");
         return false;
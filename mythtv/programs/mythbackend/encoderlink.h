@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QMap>
+#include <QAtomicInt>
 #include <QMutex>
 
 #include "tv.h"
@@ -41,7 +42,14 @@ class EncoderLink
     /// \brief Returns the remote host for a non-local EncoderLink.
     QString GetHostName(void) const { return hostname; }
     /// \brief Returns true for a local EncoderLink.
-    bool IsLocal(void) const { return local; }
+    bool IsLocal(void) const
+    {
+#if QT_VERSION >= 0x050000
+        return local.loadAcquire();
+#else
+        return local;
+#endif
+    }
     /// \brief Returns true if the EncoderLink instance is usable.
     bool IsConnected(void) const { return (IsLocal() || sock!=NULL); }
     /// \brief Returns true if the encoder is awake.
@@ -62,7 +70,8 @@ class EncoderLink
     /// \brief Returns the cardid used to refer to the recorder in the DB.
     int GetCardID(void) const { return m_capturecardnum; }
     /// \brief Returns the TVRec used by a local EncoderLink instance.
-    TVRec *GetTVRec(void) { return tv; }
+    TVRec *GetTVRec(void) { return IsLocal() ? tv : NULL; }
+    void SetTVRec(TVRec *ltv);
 
     /// \brief Tell a slave backend to go to sleep
     bool GoToSleep(void);
@@ -147,9 +156,10 @@ class EncoderLink
     QMutex sockLock;
     QString hostname;
 
+    /// Set before local, never changed afterwards, see SetTVRec()
     TVRec *tv;
 
-    bool local;
+    QAtomicInt local;
     bool locked;
 
     SleepStatus sleepStatus;
@@ -18,12 +18,15 @@
 
 #include <QCoreApplication>
 #include <QFileInfo>
+#include <QRunnable>
 #include <QRegExp>
+#include <QTimer>
 #include <QFile>
 #include <QDir>
 #include <QMap>
 
 #include "tv_rec.h"
+#include "cardutil.h"
 #include "scheduledrecording.h"
 #include "autoexpire.h"
 #include "scheduler.h"
@@ -55,12 +58,82 @@
 #include "mediaserver.h"
 #include "httpstatus.h"
 #include "mythlogging.h"
+#include "inputmonitor.h"
+#include "mythtimer.h"
 
 #define LOC      QString("MythBackend: ")
 #define LOC_WARN QString("MythBackend, Warning: ")
 #define LOC_ERR  QString("MythBackend, Error: ")
 
+/** \brief Initializes the local TVRecs for the InputMonitor, and connects
+ *         the EncoderLinks of the cards that come back after startup.
+ */
+class BackendInputs : public InputInitializer
+{
+  public:
+    BackendInputs() : m_sched(NULL) {}
+
+    void SetScheduler(Scheduler *sched) { m_sched = sched; }
+
+    QString GetDevice(uint cardid)
+    {
+        return CardUtil::GetRawCardType(cardid) + ':' +
+            CardUtil::GetVideoDevice(cardid);
+    }
+
+    bool InitInput(uint cardid, bool create)
+    {
+        TVRec *tv = create ? new TVRec(cardid) : TVRec::GetTVRec(cardid);
+        bool ok = tv && tv->Init();
+        if (!ok)
+            delete tv;
+        return ok;
+    }
+
+    /// The card's EncoderLink must be a non-local one without a socket
+    bool AddInput(uint cardid)
+    {
+        EncoderLink *enc = tvList.value(cardid);
+        TVRec *tv = TVRec::GetTVRec(cardid);
+        if (!enc || !tv)
+            return false;
+        enc->SetTVRec(tv);
+        return true;
+    }
+
+    void InputsAdded(uint count)
+    {
+        (void) count;
+        if (m_sched)
+            m_sched->ReschedulePlace("InputAdded");
+    }
+
+  private:
+    Scheduler *m_sched;
+};
+
 static MainServer *mainServer = NULL;
+static BackendInputs backendInputs;
+static InputMonitor *inputMonitor = NULL;
+
+/// Time from the start of run_backend() and of the current startup phase
+static MythTimer startupTimer;
+static MythTimer startupPhaseTimer;
+
+/// Seconds the housekeeper waits after startup before its first run
+static const int kHouseKeeperStartDelay = 30;
+/// Milliseconds the master waits for its capture cards at startup
+static const uint kInputInitTimeout = 20 * 1000;
+
+/// Logs how long the startup phase that just ended took.
+static void log_startup_phase(const QString &phase)
+{
+    LOG(VB_GENERAL, LOG_INFO, LOC + QString("Startup: %1 took %2 ms, "
+                                            "%3 ms since start")
+        .arg(phase).arg(startupPhaseTimer.elapsed())
+        .arg(startupTimer.elapsed()));
+    startupPhaseTimer.start();
+}
 
 bool setupTVs(bool ismaster, bool &error)
 {
@@ -150,12 +223,20 @@ bool setupTVs(bool ismaster, bool &error)
         hosts.push_back(host);
     }
 
+    vector<uint> localcardids;
     for (uint i = 0; i < cardids.size(); i++)
     {
         if (hosts[i] == localhostname)
+        {
             new TVRec(cardids[i]);
+            localcardids.push_back(cardids[i]);
+        }
     }
 
+    // A slave has to wait for all its cards, the master assumes they're up
+    inputMonitor = new InputMonitor(&backendInputs);
+    inputMonitor->InitInputs(localcardids, ismaster ? kInputInitTimeout : 0);
+
     for (uint i = 0; i < cardids.size(); i++)
     {
         uint    cardid = cardids[i];
@@ -167,7 +248,7 @@ bool setupTVs(bool ismaster, bool &error)
             if (host == localhostname)
             {
                 TVRec *tv = TVRec::GetTVRec(cardid);
-                if (tv && tv->Init())
+                if (tv && inputMonitor->IsReady(cardid))
                 {
                     EncoderLink *enc = new EncoderLink(cardid, tv);
                     tvList[cardid] = enc;
@@ -176,7 +257,6 @@ bool setupTVs(bool ismaster, bool &error)
                 {
                     LOG(VB_GENERAL, LOG_ERR, "Problem with capture cards. " +
                             cidmsg + " failed init");
-                    delete tv;
                     // The master assumes card comes up so we need to
                     // set error and exit if a non-master card fails.
                     error = true;
@@ -188,16 +268,21 @@ bool setupTVs(bool ismaster, bool &error)
             if (host == localhostname)
             {
                 TVRec *tv = TVRec::GetTVRec(cardid);
-                if (tv && tv->Init())
+                if (tv && inputMonitor->IsReady(cardid))
                 {
                     EncoderLink *enc = new EncoderLink(cardid, tv);
                     tvList[cardid] = enc;
                 }
                 else
                 {
-                    LOG(VB_GENERAL, LOG_ERR, "Problem with capture cards" +
-                            cidmsg + "failed init");
-                    delete tv;
+                    // Added once the device shows up, until then the
+                    // card is treated like one of a slave that is down.
+                    LOG(VB_GENERAL, LOG_ERR, "Problem with capture cards " +
+                            cidmsg + " failed init, will retry");
+                    EncoderLink *enc =
+                        new EncoderLink(cardid, NULL, localhostname);
+                    tvList[cardid] = enc;
+                    inputMonitor->Monitor(cardid);
                 }
             }
             else
@@ -228,6 +313,9 @@ void cleanup(void)
     if (gCoreContext)
         gCoreContext->SetExiting();
 
+    delete inputMonitor;
+    inputMonitor = NULL;
+
     delete housekeeping;
     housekeeping = NULL;
 
@@ -550,6 +638,9 @@ void print_warnings(const MythBackendCommandLineParser &cmdline)
 
 int run_backend(MythBackendCommandLineParser &cmdline)
 {
+    startupTimer.start();
+    startupPhaseTimer.start();
+
     gBackendContext = new BackendContext();
 
     if (!DBUtil::CheckTimeZoneSupport())
@@ -569,6 +660,8 @@ int run_backend(MythBackendCommandLineParser &cmdline)
         return GENERIC_EXIT_DB_OUTOFDATE;
     }
 
+    log_startup_phase("Database checks");
+
     MythTranslation::load("mythfrontend");
 
     if (!ismaster)
@@ -576,6 +669,8 @@ int run_backend(MythBackendCommandLineParser &cmdline)
         int ret = connect_to_master();
         if (ret != GENERIC_EXIT_OK)
             return ret;
+
+        log_startup_phase("Connecting to the master");
     }
 
     int     port = gCoreContext->GetBackendServerPort();
@@ -608,6 +703,8 @@ int run_backend(MythBackendCommandLineParser &cmdline)
         return GENERIC_EXIT_SETUP_ERROR;
     }
 
+    log_startup_phase("Capture card setup");
+
     Scheduler *sched = NULL;
     if (ismaster)
     {
@@ -629,6 +726,9 @@ int run_backend(MythBackendCommandLineParser &cmdline)
                 sched->SetExpirer(expirer);
         }
         gCoreContext->SetScheduler(sched);
+        backendInputs.SetScheduler(sched);
+
+        log_startup_phase("Scheduler setup");
     }
 
     if (!cmdline.toBool("nohousekeeper"))
@@ -651,7 +751,9 @@ int run_backend(MythBackendCommandLineParser &cmdline)
  #endif
 #endif
 
-        housekeeping->Start();
+        // Its startup tasks can wait until clients are being served
+        QTimer::singleShot(kHouseKeeperStartDelay * 1000,
+                           housekeeping, SLOT(Start()));
     }
 
     if (!cmdline.toBool("nojobqueue"))
@@ -666,6 +768,8 @@ int run_backend(MythBackendCommandLineParser &cmdline)
         g_pUPnp = new MediaServer();
 
         g_pUPnp->Init(ismaster, cmdline.toBool("noupnp"));
+
+        log_startup_phase("UPnP setup");
     }
 
     // ----------------------------------------------------------------------
@@ -698,8 +802,12 @@ int run_backend(MythBackendCommandLineParser &cmdline)
     if (httpStatus && mainServer)
         httpStatus->SetMainServer(mainServer);
 
+    log_startup_phase("Protocol server setup");
+
     StorageGroup::CheckAllStorageGroupDirs();
 
+    log_startup_phase("Storage group checks");
+
     if (gCoreContext->IsMasterBackend())
         gCoreContext->SendSystemEvent("MASTER_STARTED");
 
@@ -195,6 +195,25 @@ QStringList Myth::GetKeys()
 //
 /////////////////////////////////////////////////////////////////////////////
 
+QStringList Myth::GetDatabaseStats()
+{
+    QStringList oResults = GetMythDB()->GetDBManager()->GetStats();
+
+    QMap<QString,uint> settings = GetMythDB()->GetSettingsQueryCounts();
+    QMap<QString,uint>::const_iterator it = settings.begin();
+    for (; it != settings.end(); ++it)
+    {
+        oResults.append( QString( "Settings queries from '%1': %2" )
+                             .arg( it.key() ).arg( *it ) );
+    }
+
+    return oResults;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 DTC::StorageGroupDirList *Myth::GetStorageGroupDirs( const QString &sGroupName,
                                                      const QString &sHostName )
 {
@@ -46,6 +46,7 @@ class Myth : public MythServices
         QString             GetHostName         ( );
         QStringList         GetHosts            ( );
         QStringList         GetKeys             ( );
+        QStringList         GetDatabaseStats    ( );
 
         DTC::StorageGroupDirList*  GetStorageGroupDirs ( const QString   &GroupName,
                                                          const QString   &HostName );
@@ -175,6 +176,7 @@ class ScriptableMyth : public QObject
         QString     GetHostName() { return m_obj.GetHostName(); }
         QStringList GetHosts   () { return m_obj.GetHosts();    }
         QStringList GetKeys    () { return m_obj.GetKeys ();    }
+        QStringList GetDatabaseStats() { return m_obj.GetDatabaseStats(); }
 
         QObject* GetStorageGroupDirs ( const QString   &GroupName,
                                        const QString   &HostName )
@@ -331,6 +331,46 @@ public:
     QVector<bool> m_unavailables;
 };
 
+// Loads the program lists of the pages around the one shown into the
+// guide cache, so moving to them doesn't have to wait for the database.
+class GuidePrefetch : public GuideUpdaterBase
+{
+public:
+    GuidePrefetch(GuideGrid *guide, uint startChan, const QDateTime &startTime)
+        : GuideUpdaterBase(guide), m_currentStartChannel(startChan),
+          m_currentStartTime(startTime) {}
+    void Add(uint chanid, const QDateTime &start, const QDateTime &end)
+    {
+        m_chanids.push_back(chanid);
+        m_starts.push_back(start);
+        m_ends.push_back(end);
+    }
+    virtual bool ExecuteNonUI(void)
+    {
+        for (int i = 0; i < m_chanids.size(); ++i)
+        {
+            // Give way to the page load queued when the user moves on.
+            if (m_guide->IsPrefetchStopped() ||
+                m_currentStartChannel != m_guide->GetCurrentStartChannel() ||
+                m_currentStartTime != m_guide->GetCurrentStartTime())
+            {
+                break;
+            }
+            delete m_guide->getProgramList(m_chanids[i],
+                                           m_starts[i], m_ends[i]);
+        }
+        return false;
+    }
+    virtual void ExecuteUI(void) {}
+
+private:
+    const uint m_currentStartChannel;
+    const QDateTime m_currentStartTime;
+    QVector<uint> m_chanids;
+    QVector<QDateTime> m_starts;
+    QVector<QDateTime> m_ends;
+};
+
 class UpdateGuideEvent : public QEvent
 {
 public:
@@ -480,6 +520,7 @@ GuideGrid::GuideGrid(MythScreenStack *parent,
          : ScheduleCommon(parent, "guidegrid"),
            m_selectRecThreshold(gCoreContext->GetNumSetting("SelChangeRecThreshold", 16)),
            m_allowFinder(allowFinder),
+           m_stopPrefetch(false),
            m_currentStartChannel(0),
            m_startChanID(chanid),
            m_startChanNum(channum),
@@ -579,7 +620,7 @@ bool GuideGrid::Create()
 
 void GuideGrid::Load(void)
 {
-    LoadFromScheduler(m_recList);
+    loadRecList();
     fillChannelInfos();
 
     int maxchannel = max((int)GetChannelCount() - 1, 0);
@@ -629,10 +670,13 @@ void GuideGrid::Init(void)
 
 GuideGrid::~GuideGrid()
 {
+    m_stopPrefetch = true;
     GuideHelper::Wait(this);
 
     gCoreContext->removeListener(this);
 
+    clearGuideCache();
+
     while (!m_programs.empty())
     {
         if (m_programs.back())
@@ -1332,27 +1376,128 @@ void GuideGrid::fillProgramInfos(bool useExistingData)
 
 ProgramList *GuideGrid::getProgramListFromProgram(int chanNum)
 {
-    ProgramList *proglist = new ProgramList();
+    return getProgramList(GetChannelInfo(chanNum)->chanid,
+                          m_currentStartTime, m_currentEndTime);
+}
+
+/// Number of channel rows kept in the guide cache.
+static const int kGuideCacheMaxRows = 2000;
+
+/** \brief Returns the programs on chanid between start and end, with
+ *         their recording status, from the guide cache if possible.
+ *
+ *   Safe to call from the helper threads, the caller owns the list.
+ */
+ProgramList *GuideGrid::getProgramList(uint chanid, const QDateTime &start,
+                                       const QDateTime &end)
+{
+    QDateTime startts = start.addSecs(0 - start.time().second());
+    QDateTime endts = end.addSecs(0 - end.time().second());
+    QString key = QString("%1 %2 %3").arg(chanid)
+        .arg(startts.toTime_t()).arg(endts.toTime_t());
 
-    if (proglist)
     {
-        MSqlBindings bindings;
-        QString querystr = "WHERE program.chanid = :CHANID "
-                           "  AND program.endtime >= :STARTTS "
-                           "  AND program.starttime <= :ENDTS "
-                           "  AND program.manualid = 0 ";
-        bindings[":CHANID"]  = GetChannelInfo(chanNum)->chanid;
-        bindings[":STARTTS"] =
-            m_currentStartTime.addSecs(0 - m_currentStartTime.time().second());
-        bindings[":ENDTS"] =
-            m_currentEndTime.addSecs(0 - m_currentEndTime.time().second());
+        QMutexLocker locker(&m_guideCacheLock);
+        QMap<QString, ProgramList*>::iterator it = m_guideCache.find(key);
+        if (it != m_guideCache.end())
+            return CopyProglist(*it);
+    }
+
+    ProgramList *proglist = new ProgramList();
+
+    MSqlBindings bindings;
+    QString querystr = "WHERE program.chanid = :CHANID "
+                       "  AND program.endtime >= :STARTTS "
+                       "  AND program.starttime <= :ENDTS "
+                       "  AND program.manualid = 0 ";
+    bindings[":CHANID"]  = chanid;
+    bindings[":STARTTS"] = startts;
+    bindings[":ENDTS"]   = endts;
 
-        LoadFromProgram(*proglist, querystr, bindings, m_recList);
+    // Keep the scheduler snapshot until the list is cached, so that
+    // loadRecList() can't drop the cache in between and leave a list
+    // with the old recording status behind.
+    QReadLocker recListLocker(&m_recListLock);
+    LoadFromProgram(*proglist, querystr, bindings, m_recList);
+
+    QMutexLocker locker(&m_guideCacheLock);
+    if (!m_guideCache.contains(key))
+    {
+        m_guideCache[key] = CopyProglist(proglist);
+        m_guideCacheOrder.push_back(key);
+        while (m_guideCacheOrder.size() > kGuideCacheMaxRows)
+            delete m_guideCache.take(m_guideCacheOrder.takeFirst());
     }
 
     return proglist;
 }
 
+/// Reloads the scheduled recordings, the cached program lists carry
+/// the old recording status and are dropped.
+void GuideGrid::loadRecList(void)
+{
+    QWriteLocker locker(&m_recListLock);
+    LoadFromScheduler(m_recList);
+    clearGuideCache();
+}
+
+void GuideGrid::clearGuideCache(void)
+{
+    QMutexLocker locker(&m_guideCacheLock);
+    QMap<QString, ProgramList*>::iterator it = m_guideCache.begin();
+    for (; it != m_guideCache.end(); ++it)
+        delete *it;
+    m_guideCache.clear();
+    m_guideCacheOrder.clear();
+}
+
+/** \brief Queues loading of the pages next to the one shown.
+ *
+ *   The next and previous time windows of the channels shown go first,
+ *   then the same window for the pages of channels below and above.
+ *   The helper pool has a single thread and this runs at a lower
+ *   priority than the page loads, so it only uses idle time.
+ */
+void GuideGrid::prefetchAdjacentPages(void)
+{
+    int chanCount = GetChannelCount();
+    int rows = min(m_channelCount, chanCount);
+    int window = m_currentStartTime.secsTo(m_currentEndTime);
+    if (rows <= 0 || window <= 0)
+        return;
+
+    QVector<uint> shown, below, above;
+    for (int row = 0; row < rows; ++row)
+    {
+        int offsets[3] = { 0, rows, chanCount - rows };
+        QVector<uint> *lists[3] = { &shown, &below, &above };
+        for (int i = 0; i < 3; ++i)
+        {
+            uint idx = (m_currentStartChannel + row + offsets[i]) % chanCount;
+            const ChannelInfo *chinfo = GetChannelInfo(idx);
+            if (chinfo)
+                lists[i]->push_back(chinfo->chanid);
+        }
+    }
+
+    GuidePrefetch *prefetch =
+        new GuidePrefetch(this, m_currentStartChannel, m_currentStartTime);
+    QDateTime next = m_currentEndTime.addSecs(window);
+    QDateTime prev = m_currentStartTime.addSecs(-window);
+    for (int i = 0; i < shown.size(); ++i)
+        prefetch->Add(shown[i], m_currentEndTime, next);
+    for (int i = 0; i < shown.size(); ++i)
+        prefetch->Add(shown[i], prev, m_currentStartTime);
+    if (chanCount > rows)
+    {
+        for (int i = 0; i < below.size(); ++i)
+            prefetch->Add(below[i], m_currentStartTime, m_currentEndTime);
+        for (int i = 0; i < above.size(); ++i)
+            prefetch->Add(above[i], m_currentStartTime, m_currentEndTime);
+    }
+    m_threadPool.start(new GuideHelper(this, prefetch), "GuidePrefetch", 1);
+}
+
 void GuideGrid::fillProgramRowInfos(int firstRow, bool useExistingData)
 {
     bool allRows = false;
@@ -1415,6 +1560,9 @@ void GuideGrid::fillProgramRowInfos(int firstRow, bool useExistingData)
     GuideUpdateProgramRow *updater =
         new GuideUpdateProgramRow(this, gs, proglists);
     m_threadPool.start(new GuideHelper(this, updater), "GuideHelper");
+
+    if (allRows)
+        prefetchAdjacentPages();
 }
 
 void GuideUpdateProgramRow::fillProgramRowInfosWith(int row, int chanNum,
@@ -1660,7 +1808,7 @@ void GuideGrid::customEvent(QEvent *event)
 
         if (message == "SCHEDULE_CHANGE")
         {
-            LoadFromScheduler(m_recList);
+            loadRecList();
             fillProgramInfos();
         }
         else if (message == "STOP_VIDEO_REFRESH_TIMER")
@@ -2051,7 +2199,7 @@ void GuideGrid::generateListings()
     maxchannel = max((int)GetChannelCount() - 1, 0);
     m_channelCount = min(m_guideGrid->getChannelCount(), maxchannel + 1);
 
-    LoadFromScheduler(m_recList);
+    loadRecList();
     fillProgramInfos();
 }
 
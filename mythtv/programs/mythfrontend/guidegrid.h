@@ -11,6 +11,10 @@ using namespace std;
 #include <QDateTime>
 #include <QEvent>
 #include <QLinkedList>
+#include <QReadWriteLock>
+#include <QStringList>
+#include <QMutex>
+#include <QMap>
 
 // myth
 #include "mythscreentype.h"
@@ -133,6 +137,7 @@ class GuideGrid : public ScheduleCommon, public JumpToChannelListener
     // skip the work if not.
     uint GetCurrentStartChannel(void) const { return m_currentStartChannel; }
     QDateTime GetCurrentStartTime(void) const { return m_currentStartTime; }
+    bool IsPrefetchStopped(void) const { return m_stopPrefetch; }
 
   protected slots:
     void cursorLeft();
@@ -210,6 +215,8 @@ class GuideGrid : public ScheduleCommon, public JumpToChannelListener
 public:
     // These need to be public so that the helper classes can operate.
     ProgramList *getProgramListFromProgram(int chanNum);
+    ProgramList *getProgramList(uint chanid, const QDateTime &start,
+                                const QDateTime &end);
     void updateProgramsUI(unsigned int firstRow, unsigned int numRows,
                           int progPast,
                           const QVector<ProgramList*> &proglists,
@@ -229,6 +236,9 @@ private:
     int                  GetStartChannelOffset(int row = -1) const;
 
     ProgramList GetProgramList(uint chanid) const;
+    void loadRecList(void);
+    void clearGuideCache(void);
+    void prefetchAdjacentPages(void);
     uint GetAlternateChannelIndex(uint chan_idx, bool with_same_channum) const;
     void updateDateText(void);
 
@@ -242,6 +252,15 @@ private:
     vector<ProgramList*> m_programs;
     ProgInfoGuideArray m_programInfos;
     ProgramList  m_recList;
+    /// Held for writing while m_recList is reloaded
+    QReadWriteLock m_recListLock;
+
+    /// Program lists of the pages shown or prefetched, keyed by
+    /// channel and time window, oldest first in m_guideCacheOrder
+    QMap<QString, ProgramList*> m_guideCache;
+    QStringList    m_guideCacheOrder;
+    QMutex         m_guideCacheLock;
+    volatile bool  m_stopPrefetch;
 
     QDateTime m_originalStartTime;
     QDateTime m_currentStartTime;
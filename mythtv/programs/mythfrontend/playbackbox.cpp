@@ -200,6 +200,41 @@ static bool comp_season_rev_less_than(
     return comp_season_rev(a, b) < 0;
 }
 
+/// Order of ProgramInfoCache, which is the order of the "All Programs" list
+static bool comp_recstart_less_than(
+    const ProgramInfo *a, const ProgramInfo *b)
+{
+    if (a->GetRecordingStartTime() == b->GetRecordingStartTime())
+        return a->GetChanID() < b->GetChanID();
+    return a->GetRecordingStartTime() < b->GetRecordingStartTime();
+}
+
+static bool comp_recstart_rev_less_than(
+    const ProgramInfo *a, const ProgramInfo *b)
+{
+    return comp_recstart_less_than(b, a);
+}
+
+typedef bool (*ProgramLessThan)(const ProgramInfo *, const ProgramInfo *);
+
+/// Returns how episodes within a group are sorted, NULL if they aren't.
+static ProgramLessThan episode_sort(const QString &episodeSort, bool reverse)
+{
+    if (episodeSort == "OrigAirDate")
+        return reverse ? comp_originalAirDate_rev_less_than :
+                         comp_originalAirDate_less_than;
+    if (episodeSort == "Id")
+        return reverse ? comp_programid_rev_less_than :
+                         comp_programid_less_than;
+    if (episodeSort == "Date")
+        return reverse ? comp_recordDate_rev_less_than :
+                         comp_recordDate_less_than;
+    if (episodeSort == "Season")
+        return reverse ? comp_season_rev_less_than :
+                         comp_season_less_than;
+    return NULL;
+}
+
 static const uint s_artDelay[] =
     { kArtworkFanTimeout, kArtworkBannerTimeout, kArtworkCoverTimeout,};
 
@@ -1672,18 +1707,7 @@ bool PlaybackBox::UpdateUILists(void)
             if (p->GetTitle().isEmpty())
                 p->SetTitle(tr("_NO_TITLE_"));
 
-            if ((((p->GetRecordingGroup() == m_recGroup) ||
-                  ((m_recGroup == "All Programs") &&
-                   (p->GetRecordingGroup() != "Deleted") &&
-                   (p->GetRecordingGroup() != "LiveTV")) ||
-                  (p->GetRecordingGroup() == "LiveTV" &&
-                   (m_viewMask & VIEW_LIVETVGRP))) &&
-                 (m_recGroupPwCache[m_recGroup] == m_curGroupPassword)) ||
-                ((m_recGroupType[m_recGroup] == "category") &&
-                 ((p->GetCategory() == m_recGroup ) ||
-                  ((p->GetCategory().isEmpty()) &&
-                   (m_recGroup == tr("Unknown")))) &&
-                 ( !m_recGroupPwCache.contains(p->GetRecordingGroup()))))
+            if (IsInRecGroupView(p))
             {
                 if ((!(m_viewMask & VIEW_WATCHED)) && p->IsWatched())
                     continue;
@@ -1810,62 +1834,16 @@ bool PlaybackBox::UpdateUILists(void)
         return false;
     }
 
-    QString episodeSort = gCoreContext->GetSetting("PlayBoxEpisodeSort", "Date");
+    ProgramLessThan lessThan = episode_sort(
+        gCoreContext->GetSetting("PlayBoxEpisodeSort", "Date"), !m_listOrder);
 
-    if (episodeSort == "OrigAirDate")
-    {
-        QMap<QString, ProgramList>::Iterator Iprog;
-        for (Iprog = m_progLists.begin(); Iprog != m_progLists.end(); ++Iprog)
-        {
-            if (!Iprog.key().isEmpty())
-            {
-                std::stable_sort((*Iprog).begin(), (*Iprog).end(),
-                                 (m_listOrder == 0) ?
-                                 comp_originalAirDate_rev_less_than :
-                                 comp_originalAirDate_less_than);
-            }
-        }
-    }
-    else if (episodeSort == "Id")
-    {
-        QMap<QString, ProgramList>::Iterator Iprog;
-        for (Iprog = m_progLists.begin(); Iprog != m_progLists.end(); ++Iprog)
-        {
-            if (!Iprog.key().isEmpty())
-            {
-                std::stable_sort((*Iprog).begin(), (*Iprog).end(),
-                                 (m_listOrder == 0) ?
-                                 comp_programid_rev_less_than :
-                                 comp_programid_less_than);
-            }
-        }
-    }
-    else if (episodeSort == "Date")
+    if (lessThan)
     {
-        QMap<QString, ProgramList>::iterator it;
+        ProgramMap::iterator it;
         for (it = m_progLists.begin(); it != m_progLists.end(); ++it)
         {
             if (!it.key().isEmpty())
-            {
-                std::stable_sort((*it).begin(), (*it).end(),
-                                 (!m_listOrder) ?
-                                 comp_recordDate_rev_less_than :
-                                 comp_recordDate_less_than);
-            }
-        }
-    }
-    else if (episodeSort == "Season")
-    {
-        QMap<QString, ProgramList>::iterator it;
-        for (it = m_progLists.begin(); it != m_progLists.end(); ++it)
-        {
-            if (!it.key().isEmpty())
-            {
-                std::stable_sort((*it).begin(), (*it).end(),
-                                 (!m_listOrder) ?
-                                 comp_season_rev_less_than :
-                                 comp_season_less_than);
-            }
+                std::stable_sort((*it).begin(), (*it).end(), lessThan);
         }
     }
 
@@ -2174,6 +2152,155 @@ bool PlaybackBox::UpdateUILists(void)
     return true;
 }
 
+/**
+ *  \brief Returns true if the recording belongs to the recording group
+ *         or category that is being shown.
+ */
+bool PlaybackBox::IsInRecGroupView(const ProgramInfo *p)
+{
+    return (((p->GetRecordingGroup() == m_recGroup) ||
+             ((m_recGroup == "All Programs") &&
+              (p->GetRecordingGroup() != "Deleted") &&
+              (p->GetRecordingGroup() != "LiveTV")) ||
+             (p->GetRecordingGroup() == "LiveTV" &&
+              (m_viewMask & VIEW_LIVETVGRP))) &&
+            (m_recGroupPwCache[m_recGroup] == m_curGroupPassword)) ||
+           ((m_recGroupType[m_recGroup] == "category") &&
+            ((p->GetCategory() == m_recGroup ) ||
+             ((p->GetCategory().isEmpty()) &&
+              (m_recGroup == tr("Unknown")))) &&
+            ( !m_recGroupPwCache.contains(p->GetRecordingGroup())));
+}
+
+/**
+ *  \brief Adds a new recording to the lists in place, where
+ *         UpdateUILists() would have put it.
+ *
+ *   Rebuilding the lists takes a noticeable time with thousands of
+ *   recordings, and every frontend does it whenever a recording starts.
+ *   Only the common case is handled here, a recording that joins groups
+ *   which are already shown.
+ *
+ *  \return false if the lists have to be rebuilt instead.
+ */
+bool PlaybackBox::InsertUIListItem(ProgramInfo *p)
+{
+    // The watch list is scored against all of its members and the
+    // search groups need the recording rules, rebuild those.
+    if (m_isFilling || m_playingSomething || m_progLists.isEmpty() ||
+        m_programInfoCache.IsLoadInProgress() ||
+        (m_viewMask & (VIEW_WATCHLIST | VIEW_SEARCHES)))
+    {
+        return false;
+    }
+
+    ProgramLessThan lessThan = episode_sort(
+        gCoreContext->GetSetting("PlayBoxEpisodeSort", "Date"), !m_listOrder);
+    if (!lessThan)
+        return false;
+
+    if (p->IsDeletePending())
+        return true;
+
+    m_progsInDB++;
+
+    if (p->GetTitle().isEmpty())
+        p->SetTitle(tr("_NO_TITLE_"));
+
+    if (!IsInRecGroupView(p) ||
+        ((!(m_viewMask & VIEW_WATCHED)) && p->IsWatched()))
+    {
+        return true;
+    }
+
+    QString recgroup = p->GetRecordingGroup();
+    if (recgroup != "Deleted" && recgroup != "LiveTV")
+    {
+        QMutexLocker locker(&m_recGroupsLock);
+        if (!m_recGroups.contains(recgroup))
+            return false;
+    }
+
+    // Same grouping as UpdateUILists()
+    QStringList groups;
+    if (m_recGroup != "LiveTV" && recgroup == "LiveTV" &&
+        (m_viewMask & VIEW_LIVETVGRP))
+    {
+        groups << tr("Live TV").toLower();
+    }
+    else
+    {
+        if ((m_viewMask & VIEW_TITLES) &&
+            (recgroup != "LiveTV" || m_recGroup == "LiveTV"))
+            groups << p->GetTitle().toLower();
+
+        if ((m_viewMask & VIEW_RECGROUPS) &&
+            !recgroup.isEmpty() && recgroup != "LiveTV")
+            groups << recgroup.toLower();
+
+        if ((m_viewMask & VIEW_CATEGORIES) && !p->GetCategory().isEmpty())
+            groups << p->GetCategory().toLower();
+    }
+
+    QStringList::const_iterator git = groups.begin();
+    for (; git != groups.end(); ++git)
+    {
+        if (!m_progLists.contains(*git))
+            return false;
+    }
+
+    if (m_viewMask != VIEW_NONE &&
+        (recgroup != "LiveTV" || m_recGroup == "LiveTV"))
+    {
+        groups.push_front("");
+    }
+
+    p->SetAvailableStatus(asAvailable, "InsertUIListItem");
+
+    for (git = groups.begin(); git != groups.end(); ++git)
+    {
+        ProgramList &list = m_progLists[*git];
+        ProgramLessThan order = lessThan;
+        if (git->isEmpty())
+        {
+            order = m_allOrder ? comp_recstart_rev_less_than :
+                                 comp_recstart_less_than;
+        }
+
+        ProgramList::iterator pit =
+            std::upper_bound(list.begin(), list.end(), p, order);
+
+        // updateRecList() doesn't show recordings being deleted
+        int pos = 0;
+        for (ProgramList::iterator it = list.begin(); it != pit; ++it)
+        {
+            if ((*it)->GetAvailableStatus() != asPendingDelete &&
+                (*it)->GetAvailableStatus() != asDeleted)
+                pos++;
+        }
+        list.insert(pit, p);
+
+        MythUIButtonListItem *groupItem =
+            m_groupList->GetItemByData(qVariantFromValue(*git));
+        if (groupItem)
+            groupItem->SetText(QString::number(list.size()), "reccount");
+
+        if (*git == m_currentGroup)
+        {
+            new PlaybackBoxListItem(this, m_recordingList, p, pos);
+            if (m_noRecordingsText)
+                m_noRecordingsText->SetVisible(false);
+        }
+    }
+
+    LOG(VB_GUI, LOG_INFO, LOC + QString("Added %1 to %2 groups in place")
+        .arg(p->MakeUniqueKey()).arg(groups.size()));
+
+    UpdateUsageUI();
+
+    return true;
+}
+
 void PlaybackBox::playSelectedPlaylist(bool _random)
 {
     if (_random)
@@ -4341,8 +4468,22 @@ void PlaybackBox::HandleRecordingRemoveEvent(
 
 void PlaybackBox::HandleRecordingAddEvent(const ProgramInfo &evinfo)
 {
-    m_programInfoCache.Add(evinfo);
-    ScheduleUpdateUIList();
+    ProgramInfo *pginfo = NULL;
+    if (evinfo.GetChanID() &&
+        !m_programInfoCache.GetProgramInfo(evinfo.GetChanID(),
+                                           evinfo.GetRecordingStartTime()))
+    {
+        m_programInfoCache.Add(evinfo);
+        pginfo = m_programInfoCache.GetProgramInfo(
+            evinfo.GetChanID(), evinfo.GetRecordingStartTime());
+    }
+    else
+    {
+        m_programInfoCache.Add(evinfo);
+    }
+
+    if (!pginfo || !InsertUIListItem(pginfo))
+        ScheduleUpdateUIList();
 }
 
 void PlaybackBox::HandleUpdateProgramInfoEvent(const ProgramInfo &evinfo)
@@ -263,6 +263,8 @@ class PlaybackBox : public ScheduleCommon
 
   private:
     bool UpdateUILists(void);
+    bool InsertUIListItem(ProgramInfo *pginfo);
+    bool IsInRecGroupView(const ProgramInfo *pginfo);
     void UpdateUIGroupList(const QStringList &groupPreferences);
     void UpdateUIRecGroupList(void);
 
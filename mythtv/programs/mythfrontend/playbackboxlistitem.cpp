@@ -4,8 +4,9 @@
 #include "mythlogging.h"
 
 PlaybackBoxListItem::PlaybackBoxListItem(
-    PlaybackBox *parent, MythUIButtonList *lbtype, ProgramInfo *pi) :
-    MythUIButtonListItem(lbtype, "", qVariantFromValue(pi)),
+    PlaybackBox *parent, MythUIButtonList *lbtype, ProgramInfo *pi,
+    int listPosition) :
+    MythUIButtonListItem(lbtype, "", qVariantFromValue(pi), listPosition),
     pbbox(parent), needs_update(true)
 {
 }
@@ -12,7 +12,8 @@ class ProgramInfo;
 class PlaybackBoxListItem : public MythUIButtonListItem
 {
   public:
-    PlaybackBoxListItem(PlaybackBox *parent, MythUIButtonList *lbtype, ProgramInfo *pi);
+    PlaybackBoxListItem(PlaybackBox *parent, MythUIButtonList *lbtype, ProgramInfo *pi,
+                        int listPosition = -1);
 
 //    virtual void SetToRealButton(MythUIStateType *button, bool selected);
 
@@ -19,6 +19,11 @@ void MythPreviewGeneratorCommandLineParser::LoadArguments(void)
     add("--size", "size", QSize(0,0), "Dimensions of preview image.", "");
     add("--infile", "inputfile", "", "Input video for preview generation.", "");
     add("--outfile", "outputfile", "", "Optional output file for preview generation.", "");
+    add("--batch", "batch", "", "Additional previews to generate from the same recording.",
+            "Semicolon separated list of previews to generate while the "
+            "recording is open, each as <s|f><time>:<width>x<height>:<outfile>. "
+            "The time is in seconds when prefixed with 's' and a frame number "
+            "when prefixed with 'f'.");
 }
 
 
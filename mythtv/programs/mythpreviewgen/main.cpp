@@ -90,7 +90,8 @@ namespace
 int preview_helper(uint chanid, QDateTime starttime,
                    long long previewFrameNumber, long long previewSeconds,
                    const QSize &previewSize,
-                   const QString &infile, const QString &outfile)
+                   const QString &infile, const QString &outfile,
+                   const QString &batch)
 {
     // Lower scheduling priority, to avoid problems with recordings.
     if (setpriority(PRIO_PROCESS, 0, 9))
@@ -143,8 +144,41 @@ int preview_helper(uint chanid, QDateTime starttime,
 
     previewgen->SetOutputSize(previewSize);
     previewgen->SetOutputFilename(outfile);
+
+    // Each batch entry is <s|f><time>:<width>x<height>:<outfile>, entries
+    // are separated by ';', so output files with a ';' are never batched
+    QList<PreviewGenerator*> batched;
+    QStringList entries = batch.split(';', QString::SkipEmptyParts);
+    QStringList::const_iterator it = entries.begin();
+    for (; it != entries.end(); ++it)
+    {
+        QString spec   = (*it).section(':', 0, 0);
+        QString size   = (*it).section(':', 1, 1);
+        QString bfile  = (*it).section(':', 2);
+        bool ok_time   = false;
+        long long time = spec.mid(1).toLongLong(&ok_time);
+        if (!ok_time || (time < 0) || bfile.isEmpty() ||
+            !(spec.startsWith('s') || spec.startsWith('f')))
+        {
+            LOG(VB_GENERAL, LOG_ERR,
+                QString("Ignoring invalid batch entry '%1'").arg(*it));
+            continue;
+        }
+
+        PreviewGenerator *pg = new PreviewGenerator(
+            pginfo, QString(), PreviewGenerator::kLocal);
+        pg->SetPreviewTime(time, spec.startsWith('s'));
+        pg->SetOutputSize(QSize(size.section('x', 0, 0).toInt(),
+                                size.section('x', 1, 1).toInt()));
+        pg->SetOutputFilename(bfile);
+        previewgen->AddToBatch(pg);
+        batched.push_back(pg);
+    }
+
     bool ok = previewgen->RunReal();
     previewgen->deleteLater();
+    while (!batched.empty())
+        batched.takeFirst()->deleteLater();
 
     delete pginfo;
 
@@ -230,7 +264,8 @@ int main(int argc, char **argv)
         cmdline.toUInt("chanid"), cmdline.toDateTime("starttime"),
         cmdline.toLongLong("frame"), cmdline.toLongLong("seconds"),
         cmdline.toSize("size"),
-        cmdline.toString("inputfile"), cmdline.toString("outputfile"));
+        cmdline.toString("inputfile"), cmdline.toString("outputfile"),
+        cmdline.toString("batch"));
     return ret;
 }
 
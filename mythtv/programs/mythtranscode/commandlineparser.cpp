@@ -36,6 +36,14 @@ void MythTranscodeCommandLineParser::LoadArguments(void)
     add(QStringList( QStringList() << "-m" << "--mpeg2" ), "mpeg2", false,
             "Specifies that a lossless transcode should be used.", "")
         ->SetGroup("Encoding");
+    add("--remux", "remux", false,
+            "Apply the cutlist by copying packets instead of re-encoding. "
+            "Cuts are moved to the nearest following keyframe.",
+            "Copies the video and audio packets between the cut points into "
+            "a new file of the same container, without decoding them. This "
+            "works for MPEG-2 as well as H.264 recordings and is limited only "
+            "by disk speed, but each kept section has to start on a keyframe.")
+        ->SetGroup("Encoding");
     add(QStringList( QStringList() << "-e" << "--ostream" ), "ostream", "",
             "Output stream type: dvd, ts", "")
         ->SetGroup("Encoding");
@@ -84,6 +92,15 @@ void MythTranscodeCommandLineParser::LoadArguments(void)
     add("--video", "video", false,
             "Specifies video is not a recording.", "")
         ->SetRequires("inputfile");
+    add("--encodethreads", "encodethreads", 0,
+            "Number of threads the video encoder may use.",
+            "Overrides the encoding thread count of the transcoding "
+            "profile, or the HTTP Live Stream thread setting with --hls. "
+            "Use 0 for one thread per CPU core.");
+    add("--decodebuffer", "decodebuffer", 0,
+            "Number of decoded frames to buffer ahead of the encoder.",
+            "Lets the decoder and filters run ahead of the encoder in "
+            "their own thread. Defaults to 5.");
     add("--queue", "queue", "",
             "Add a new transcoding job of the specified recording and "
             "profile to the jobqueue. Accepts an optional string to define "
@@ -10,6 +10,7 @@ using namespace std;
 // Qt headers
 #include <QCoreApplication>
 #include <QDir>
+#include <QThread>
 
 // MythTV headers
 #include "mythmiscutil.h"
@@ -22,6 +23,7 @@ using namespace std;
 #include "mythdate.h"
 #include "transcode.h"
 #include "mpeg2fix.h"
+#include "remuxer.h"
 #include "remotefile.h"
 #include "mythtranslation.h"
 #include "mythlogging.h"
@@ -171,6 +173,7 @@ int main(int argc, char *argv[])
     bool useCutlist = false, keyframesonly = false;
     bool build_index = false, fifosync = false;
     bool mpeg2 = false;
+    bool remux = false;
     bool fifo_info = false;
     bool cleanCut = false;
     QMap<QString, QString> settingsOverride;
@@ -362,6 +365,8 @@ int main(int argc, char *argv[])
         recorderOptions = cmdline.toString("recopt");
     if (cmdline.toBool("mpeg2"))
         mpeg2 = true;
+    if (cmdline.toBool("remux"))
+        remux = true;
     if (cmdline.toBool("ostream"))
     {
         if (cmdline.toString("ostream") == "dvd")
@@ -607,12 +612,22 @@ int main(int argc, char *argv[])
             transcode->SetCMDAudioBitrate(cmdline.toInt("audiobitrate") * 1000);
     }
 
+    if (cmdline.toBool("encodethreads"))
+    {
+        int encodeThreads = cmdline.toInt("encodethreads");
+        if (encodeThreads <= 0)
+            encodeThreads = QThread::idealThreadCount();
+        transcode->SetEncodingThreads(encodeThreads);
+    }
+    if (cmdline.toBool("decodebuffer") && (cmdline.toInt("decodebuffer") > 0))
+        transcode->SetDecodeBufferSize(cmdline.toInt("decodebuffer"));
+
     if (showprogress)
         transcode->ShowProgress(true);
     if (!recorderOptions.isEmpty())
         transcode->SetRecorderOptions(recorderOptions);
     int result = 0;
-    if ((!mpeg2 && !build_index) || cmdline.toBool("hls"))
+    if ((!mpeg2 && !remux && !build_index) || cmdline.toBool("hls"))
     {
         result = transcode->TranscodeFile(infile, outfile,
                                           profilename, useCutlist,
@@ -630,7 +645,40 @@ int main(int argc, char *argv[])
     }
 
     int exitcode = GENERIC_EXIT_OK;
-    if ((result == REENCODE_MPEG2TRANS) || mpeg2 || build_index)
+    if (((result == REENCODE_REMUX) || remux) && !build_index &&
+        !cmdline.toBool("hls"))
+    {
+        void (*update_func)(float) = NULL;
+        int (*check_func)() = NULL;
+        if (useCutlist)
+        {
+            LOG(VB_GENERAL, LOG_INFO, "Honoring the cutlist while remuxing");
+            if (deleteMap.isEmpty())
+                pginfo->QueryCutList(deleteMap);
+        }
+        if (jobID >= 0)
+        {
+           glbl_jobID = jobID;
+           update_func = &UpdateJobQueue;
+           check_func = &CheckJobQueue;
+        }
+
+        Remuxer remuxer(infile, outfile, deleteMap, update_func, check_func);
+        result = remuxer.Start();
+        if (result == REENCODE_OK)
+        {
+            // The seek table was collected while writing the file,
+            // so unlike MPEG2fixup no second pass is needed here.
+            posMap = remuxer.GetPositionMap();
+            durMap = remuxer.GetDurationMap();
+            if (update_index)
+                UpdatePositionMap(posMap, durMap, NULL, pginfo);
+            else
+                UpdatePositionMap(posMap, durMap, outfile + QString(".map"),
+                                  pginfo);
+        }
+    }
+    else if ((result == REENCODE_MPEG2TRANS) || mpeg2 || build_index)
     {
         void (*update_func)(float) = NULL;
         int (*check_func)() = NULL;
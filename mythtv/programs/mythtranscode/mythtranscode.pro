@@ -21,12 +21,12 @@ macx: QMAKE_CFLAGS -= -O3 -O2 -O1 -Os
 # Input
 SOURCES += main.cpp transcode.cpp mpeg2fix.cpp
 SOURCES += audioreencodebuffer.cpp cutter.cpp videodecodebuffer.cpp
-SOURCES += commandlineparser.cpp
+SOURCES += commandlineparser.cpp remuxer.cpp
 SOURCES += external/replex/element.c external/replex/mpg_common.c
 SOURCES += external/replex/multiplex.c external/replex/pes.c
 SOURCES += external/replex/ringbuffer.c external/replex/ts.c
 
-HEADERS += mpeg2fix.h transcodedefs.h commandlineparser.h
+HEADERS += mpeg2fix.h transcodedefs.h commandlineparser.h remuxer.h
 HEADERS += audioreencodebuffer.h cutter.h videodecodebuffer.h
 HEADERS += external/replex/element.h external/replex/mpg_common.h
 HEADERS += external/replex/multiplex.h external/replex/pes.h
@@ -0,0 +1,351 @@
+// C headers
+#include <stdint.h>
+#include <string.h>
+
+// C++ headers
+#include <algorithm>
+using namespace std;
+
+#include "remuxer.h"
+
+#include "mythlogging.h"
+#include "mythcorecontext.h"
+
+#define LOC QString("Remuxer: ")
+
+static const AVRational kMicroSecs = { 1, 1000000 };
+
+Remuxer::Remuxer(const QString &inputfile, const QString &outputfile,
+                 const frm_dir_map_t &deleteMap,
+                 void (*update_func)(float), int (*check_func)()) :
+    m_infile(inputfile),      m_outfile(outputfile),
+    m_updateFunc(update_func), m_checkFunc(check_func),
+    m_inputFC(NULL),          m_outputFC(NULL),
+    m_videoIndex(-1)
+{
+    // A cutlist may start with an end mark, or end with a start mark,
+    // to cut from the beginning or to the end of the file.
+    bool inCut = false;
+    uint64_t start = 0;
+    frm_dir_map_t::const_iterator it = deleteMap.begin();
+    for (; it != deleteMap.end(); ++it)
+    {
+        if (*it == MARK_CUT_START && !inCut)
+        {
+            start = it.key();
+            inCut = true;
+        }
+        else if (*it == MARK_CUT_END)
+        {
+            m_cuts.push_back(CutRange(inCut ? start : 0, it.key()));
+            inCut = false;
+        }
+    }
+    if (inCut)
+        m_cuts.push_back(CutRange(start, UINT64_MAX));
+}
+
+Remuxer::~Remuxer()
+{
+    Close();
+}
+
+bool Remuxer::IsCut(uint64_t frame) const
+{
+    QList<CutRange>::const_iterator it = m_cuts.begin();
+    for (; it != m_cuts.end(); ++it)
+    {
+        if (frame < (*it).first)
+            return false;
+        if (frame <= (*it).second)
+            return true;
+    }
+    return false;
+}
+
+bool Remuxer::OpenInput(void)
+{
+    QByteArray ifarray = m_infile.toLocal8Bit();
+    const char *ifname = ifarray.constData();
+
+    LOG(VB_GENERAL, LOG_INFO, LOC + QString("Opening %1").arg(m_infile));
+
+    int ret = avformat_open_input(&m_inputFC, ifname, NULL, NULL);
+    if (ret)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't open input file, error #%1").arg(ret));
+        return false;
+    }
+
+    ret = avformat_find_stream_info(m_inputFC, NULL);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't get stream info, error #%1").arg(ret));
+        return false;
+    }
+
+    if (VERBOSE_LEVEL_CHECK(VB_GENERAL, LOG_INFO))
+        av_dump_format(m_inputFC, 0, ifname, 0);
+
+    m_videoIndex = av_find_best_stream(m_inputFC, AVMEDIA_TYPE_VIDEO,
+                                       -1, -1, NULL, 0);
+    if (m_videoIndex < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "No video stream found");
+        return false;
+    }
+
+    return true;
+}
+
+bool Remuxer::OpenOutput(void)
+{
+    // Keep the container of the recording, MPEG-PS is written as VOB
+    // so the pack headers stay DVD compatible.
+    QString format = QString(m_inputFC->iformat->name).section(',', 0, 0);
+    if (format.startsWith("mpegts"))
+        format = "mpegts";
+    else if (format == "mpeg")
+        format = "vob";
+
+    QByteArray ofarray = m_outfile.toLocal8Bit();
+    int ret = avformat_alloc_output_context2(
+        &m_outputFC, NULL, format.toLatin1().constData(), ofarray.constData());
+    if (ret < 0 || !m_outputFC)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't create '%1' output, error #%2")
+                .arg(format).arg(ret));
+        return false;
+    }
+
+    for (uint i = 0; i < m_inputFC->nb_streams; i++)
+    {
+        AVStream *ist = m_inputFC->streams[i];
+        bool copy = ((int)i == m_videoIndex) ||
+            (ist->codec->codec_type == AVMEDIA_TYPE_AUDIO);
+
+        if (!copy)
+        {
+            m_streamMap.push_back(-1);
+            continue;
+        }
+
+        AVStream *ost = avformat_new_stream(m_outputFC, NULL);
+        if (!ost || avcodec_copy_context(ost->codec, ist->codec) < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Couldn't copy stream %1").arg(i));
+            return false;
+        }
+        ost->codec->codec_tag = 0;
+        ost->time_base = ist->time_base;
+        ost->sample_aspect_ratio = ist->sample_aspect_ratio;
+        if (m_outputFC->oformat->flags & AVFMT_GLOBALHEADER)
+            ost->codec->flags |= CODEC_FLAG_GLOBAL_HEADER;
+        av_dict_copy(&ost->metadata, ist->metadata, 0);
+
+        m_streamMap.push_back(ost->index);
+    }
+
+    if (!(m_outputFC->oformat->flags & AVFMT_NOFILE))
+    {
+        ret = avio_open(&m_outputFC->pb, ofarray.constData(), AVIO_FLAG_WRITE);
+        if (ret < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Couldn't open output file '%1', error #%2")
+                    .arg(m_outfile).arg(ret));
+            return false;
+        }
+    }
+
+    ret = avformat_write_header(m_outputFC, NULL);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't write header, error #%1").arg(ret));
+        return false;
+    }
+
+    return true;
+}
+
+void Remuxer::Close(void)
+{
+    if (m_outputFC)
+    {
+        if (m_outputFC->pb && !(m_outputFC->oformat->flags & AVFMT_NOFILE))
+            avio_closep(&m_outputFC->pb);
+        avformat_free_context(m_outputFC);
+        m_outputFC = NULL;
+    }
+
+    if (m_inputFC)
+    {
+        avformat_close_input(&m_inputFC);
+        m_inputFC = NULL;
+    }
+}
+
+int Remuxer::Start(void)
+{
+    if (!OpenInput() || !OpenOutput())
+    {
+        Close();
+        return REENCODE_ERROR;
+    }
+
+    AVStream *vst      = m_inputFC->streams[m_videoIndex];
+    AVRational rate    = vst->avg_frame_rate.num ?
+        vst->avg_frame_rate : vst->r_frame_rate;
+    int64_t frameUSecs = rate.num ?
+        av_rescale_q(1, av_inv_q(rate), kMicroSecs) : 0;
+    int64_t fileSize   = avio_size(m_inputFC->pb);
+    bool    isTS       = !strcmp(m_outputFC->oformat->name, "mpegts");
+
+    int64_t  firstDts     = AV_NOPTS_VALUE; // of the first video packet
+    int64_t  inFrame      = -1;    // last video frame read, cutlist numbering
+    uint64_t outFrame     = 0;     // video frames written
+    bool     keeping      = false; // inside a kept section
+    int64_t  offset       = 0;     // time removed so far, in usecs
+    int64_t  sectionStart = AV_NOPTS_VALUE;
+    int64_t  nextDts      = AV_NOPTS_VALUE; // end of last kept video frame
+    int64_t  durationUSecs = 0;
+    int      lastPercent  = -1;
+    int      result       = REENCODE_OK;
+
+    AVPacket pkt;
+    av_init_packet(&pkt);
+    pkt.data = NULL;
+    pkt.size = 0;
+
+    while (av_read_frame(m_inputFC, &pkt) >= 0)
+    {
+        AVStream *ist = m_inputFC->streams[pkt.stream_index];
+        int outIndex  = (pkt.stream_index < m_streamMap.size()) ?
+            m_streamMap[pkt.stream_index] : -1;
+        int64_t dts   = (pkt.dts == AV_NOPTS_VALUE) ? AV_NOPTS_VALUE :
+            av_rescale_q(pkt.dts, ist->time_base, kMicroSecs);
+
+        if (pkt.stream_index == m_videoIndex)
+        {
+            // Field coded streams carry one packet per field, so frames
+            // are numbered from the timestamps rather than counted.  A
+            // packet less than 3/4 of a frame after the last frame start
+            // belongs to the same frame.
+            int64_t frame = inFrame + 1;
+            if (dts != AV_NOPTS_VALUE && frameUSecs > 0)
+            {
+                if (firstDts == AV_NOPTS_VALUE)
+                    firstDts = dts;
+                frame = max((int64_t)0, dts - firstDts + frameUSecs / 4) /
+                    frameUSecs;
+            }
+            bool newFrame = frame > inFrame;
+            if (newFrame)
+                inFrame = frame;
+
+            if (IsCut(inFrame))
+            {
+                keeping = false;
+            }
+            else if (!keeping && (pkt.flags & AV_PKT_FLAG_KEY) &&
+                     (dts != AV_NOPTS_VALUE))
+            {
+                // A kept section starts, close the gap to the last one.
+                if (nextDts != AV_NOPTS_VALUE)
+                    offset += dts - nextDts;
+                sectionStart = dts;
+                keeping = true;
+            }
+
+            if (!keeping)
+            {
+                av_free_packet(&pkt);
+                continue;
+            }
+
+            int64_t dur = (pkt.duration > 0) ?
+                av_rescale_q(pkt.duration, ist->time_base, kMicroSecs) :
+                (newFrame ? frameUSecs : 0);
+            if (dts != AV_NOPTS_VALUE)
+                nextDts = dts + dur;
+
+            // The seek table is built from what we write, no second
+            // pass over the output is needed.
+            if (newFrame && (pkt.flags & AV_PKT_FLAG_KEY))
+            {
+                m_posMap[outFrame] = avio_tell(m_outputFC->pb);
+                m_durMap[outFrame] = durationUSecs / 1000;
+            }
+            durationUSecs += dur;
+            if (newFrame)
+                outFrame++;
+        }
+        else if (outIndex < 0 || !keeping ||
+                 (dts != AV_NOPTS_VALUE && dts < sectionStart))
+        {
+            av_free_packet(&pkt);
+            continue;
+        }
+
+        AVStream *ost = m_outputFC->streams[outIndex];
+        int64_t streamOffset = av_rescale_q(offset, kMicroSecs, ist->time_base);
+        if (pkt.pts != AV_NOPTS_VALUE)
+            pkt.pts = av_rescale_q(pkt.pts - streamOffset,
+                                   ist->time_base, ost->time_base);
+        if (pkt.dts != AV_NOPTS_VALUE)
+            pkt.dts = av_rescale_q(pkt.dts - streamOffset,
+                                   ist->time_base, ost->time_base);
+        pkt.duration = av_rescale_q(pkt.duration,
+                                    ist->time_base, ost->time_base);
+        pkt.stream_index = outIndex;
+        pkt.pos = -1;
+
+        // The input is already interleaved, writing TS packets directly
+        // keeps the byte positions in the seek table exact.
+        int ret = isTS ? av_write_frame(m_outputFC, &pkt) :
+            av_interleaved_write_frame(m_outputFC, &pkt);
+        av_free_packet(&pkt);
+        if (ret < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Error writing frame, error #%1").arg(ret));
+            result = REENCODE_ERROR;
+            break;
+        }
+
+        if (fileSize > 0)
+        {
+            int percent = avio_tell(m_inputFC->pb) * 100 / fileSize;
+            if (percent != lastPercent)
+            {
+                lastPercent = percent;
+                if (m_updateFunc)
+                    (*m_updateFunc)(percent);
+                if (m_checkFunc && (*m_checkFunc)())
+                {
+                    result = REENCODE_STOPPED;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (result == REENCODE_OK)
+    {
+        av_write_trailer(m_outputFC);
+        LOG(VB_GENERAL, LOG_NOTICE, LOC +
+            QString("Copied %1 of %2 video frames, %3 keyframes indexed")
+                .arg(outFrame).arg(inFrame + 1).arg(m_posMap.size()));
+    }
+
+    Close();
+
+    return result;
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
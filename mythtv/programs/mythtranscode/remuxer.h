@@ -0,0 +1,70 @@
+#ifndef REMUXER_H
+#define REMUXER_H
+
+#include <QString>
+#include <QList>
+#include <QPair>
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+
+#include "transcodedefs.h"
+#include "programtypes.h"
+
+/** \class Remuxer
+ *  \brief Applies a cutlist by copying packets instead of re-encoding.
+ *
+ *   Video and audio packets are copied untouched between the cut points,
+ *   so the whole file costs little more than the I/O.  Since nothing is
+ *   decoded, each kept section has to start on a keyframe: a cut ends
+ *   at the first keyframe at or after its end mark.  Timestamps are
+ *   shifted to close the gaps, and the seek table of the output is
+ *   collected while writing so no second pass over the file is needed.
+ *   Frames are numbered from the video timestamps, not by counting
+ *   packets, so field coded streams are cut at the right frames too.
+ *
+ *   This works for any codec libavformat can stream copy, in particular
+ *   MPEG-2 and H.264 in MPEG-TS.
+ */
+class Remuxer
+{
+  public:
+    Remuxer(const QString &inputfile, const QString &outputfile,
+            const frm_dir_map_t &deleteMap,
+            void (*update_func)(float) = NULL,
+            int (*check_func)() = NULL);
+    ~Remuxer();
+
+    int Start(void);
+
+    const frm_pos_map_t &GetPositionMap(void) const { return m_posMap; }
+    const frm_pos_map_t &GetDurationMap(void) const { return m_durMap; }
+
+  private:
+    bool OpenInput(void);
+    bool OpenOutput(void);
+    void Close(void);
+    bool IsCut(uint64_t frame) const;
+
+  private:
+    typedef QPair<uint64_t,uint64_t> CutRange; // [first, last] inclusive
+
+    QString          m_infile;
+    QString          m_outfile;
+    QList<CutRange>  m_cuts;
+    void           (*m_updateFunc)(float);
+    int            (*m_checkFunc)();
+
+    AVFormatContext *m_inputFC;
+    AVFormatContext *m_outputFC;
+    int              m_videoIndex;
+    /// input stream index -> output stream index, -1 if not copied
+    QList<int>       m_streamMap;
+
+    frm_pos_map_t    m_posMap;
+    frm_pos_map_t    m_durMap;
+};
+
+#endif
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
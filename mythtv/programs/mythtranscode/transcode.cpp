@@ -1,6 +1,7 @@
 #include <fcntl.h>
 #include <math.h>
 #include <iostream>
+#include <algorithm>
 
 #include <QStringList>
 #include <QMap>
@@ -20,6 +21,7 @@
 #include "jobqueue.h"
 #include "exitcodes.h"
 #include "mthreadpool.h"
+#include "mythtimer.h"
 #include "deletemap.h"
 #include "tvremoteutil.h"
 
@@ -43,6 +45,10 @@ using namespace std;
 
 #define LOC QString("Transcode: ")
 
+// The null video output has 31 frames and keeps one of them free, the
+// frame being encoded comes out of the same pool.
+static const int kMaxDecodeBufferSize = 31 - 1 - 1;
+
 Transcode::Transcode(ProgramInfo *pginfo) :
     m_proginfo(pginfo),
     m_recProfile(new RecordingProfile("Transcoders")),
@@ -61,7 +67,8 @@ Transcode::Transcode(ProgramInfo *pginfo) :
     cmdContainer("mpegts"),         cmdAudioCodec("aac"),
     cmdVideoCodec("libx264"),
     cmdWidth(480),                  cmdHeight(0),
-    cmdBitrate(600000),             cmdAudioBitrate(64000)
+    cmdBitrate(600000),             cmdAudioBitrate(64000),
+    encodingThreads(0),             decodeBufferSize(5)
 {
 }
 
@@ -218,6 +225,7 @@ int Transcode::TranscodeFile(const QString &inputname,
     HTTPLiveStream *hls = NULL;
     int hlsSegmentSize = 0;
     int hlsSegmentFrames = 0;
+    float hlsFrameRate = 0.0;
 
     if (jobID >= 0)
         JobQueue::ChangeJobComment(jobID, "0% " + QObject::tr("Completed"));
@@ -548,7 +556,7 @@ int Transcode::TranscodeFile(const QString &inputname,
                 if (avfw2)
                     avfw2->SetFramerate(video_frame_rate/2);
 
-                hlsSegmentSize = (int)(segmentSize * video_frame_rate / 2);
+                hlsFrameRate = video_frame_rate / 2;
             }
             else
             {
@@ -557,14 +565,19 @@ int Transcode::TranscodeFile(const QString &inputname,
                 if (avfw2)
                     avfw2->SetFramerate(video_frame_rate);
 
-                hlsSegmentSize = (int)(segmentSize * video_frame_rate);
+                hlsFrameRate = video_frame_rate;
             }
 
-            avfw->SetKeyFrameDist(30);
+            // One keyframe per second, segments are whole seconds long
+            // and can only be cut at a keyframe.
+            int keyFrameDist = max(1, (int)(hlsFrameRate + 0.5f));
+            avfw->SetKeyFrameDist(keyFrameDist);
             if (avfw2)
-                avfw2->SetKeyFrameDist(30);
+                avfw2->SetKeyFrameDist(keyFrameDist);
 
             hls->AddSegment();
+            hlsSegmentSize =
+                (int)(hls->GetCurrentSegmentDuration() * hlsFrameRate);
             avfw->SetFilename(hls->GetCurrentFilename());
             if (avfw2)
                 avfw2->SetFilename(hls->GetCurrentFilename(true));
@@ -580,6 +593,8 @@ int Transcode::TranscodeFile(const QString &inputname,
         }
 
         int threads    = gCoreContext->GetNumSetting("HTTPLiveStreamThreads", 2);
+        if (encodingThreads > 0)
+            threads = encodingThreads;
         QString preset = gCoreContext->GetSetting("HTTPLiveStreamPreset", "veryfast");
         QString tune   = gCoreContext->GetSetting("HTTPLiveStreamTune", "film");
 
@@ -682,6 +697,14 @@ int Transcode::TranscodeFile(const QString &inputname,
             return REENCODE_MPEG2TRANS;
         }
 
+        if (encodingType == "H.264" &&
+            get_int_option(m_recProfile, "transcodelossless"))
+        {
+            LOG(VB_GENERAL, LOG_NOTICE, "Switching to packet copy remuxer.");
+            SetPlayerContext(NULL);
+            return REENCODE_REMUX;
+        }
+
         // Recorder setup
         if (get_int_option(m_recProfile, "transcodelossless"))
         {
@@ -790,6 +813,13 @@ int Transcode::TranscodeFile(const QString &inputname,
             return REENCODE_ERROR;
         }
 
+        if (encodingThreads > 0)
+        {
+            LOG(VB_GENERAL, LOG_INFO,
+                QString("Using %1 encoding threads").arg(encodingThreads));
+            nvr->SetOption("encodingthreadcount", encodingThreads);
+        }
+
         nvr->SetOption("samplerate", arb->m_eff_audiorate);
         if (audsetting == "MP3")
         {
@@ -1062,13 +1092,29 @@ int Transcode::TranscodeFile(const QString &inputname,
     else
         LOG(VB_GENERAL, LOG_INFO, "Transcoding Video and Audio");
 
+    if (decodeBufferSize > kMaxDecodeBufferSize)
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            QString("Decode buffer of %1 frames is more than the video "
+                    "output has, using %2")
+                .arg(decodeBufferSize).arg(kMaxDecodeBufferSize));
+        decodeBufferSize = kMaxDecodeBufferSize;
+    }
+
     VideoDecodeBuffer *videoBuffer =
-        new VideoDecodeBuffer(GetPlayer(), videoOutput, honorCutList);
+        new VideoDecodeBuffer(GetPlayer(), videoOutput, honorCutList,
+                              max(decodeBufferSize, 1));
     MThreadPool::globalInstance()->start(videoBuffer, "VideoDecodeBuffer");
 
     QTime flagTime;
     flagTime.start();
 
+    // Time spent in the encode/mux stage, i.e. in this loop after the
+    // decoder thread handed us a frame, to show which stage is the
+    // bottleneck in the job status.
+    MythTimer encodeTimer;
+    int64_t encodeNsecs = 0;
+
     if (cutter)
         cutter->Activate(vidFrameTime * rateTimeConv, total_frame_count);
 
@@ -1084,6 +1130,8 @@ int Transcode::TranscodeFile(const QString &inputname,
     while ((!stopSignalled) &&
            (lastDecode = videoBuffer->GetFrame(did_ff, is_key)))
     {
+        encodeTimer.start();
+
         if (first_loop)
         {
             copyaudio = GetPlayer()->GetRawAudioState();
@@ -1442,10 +1490,14 @@ int Transcode::TranscodeFile(const QString &inputname,
 
                     if ((hls) &&
                         (avfw->GetFramesWritten()) &&
-                        (hlsSegmentFrames > hlsSegmentSize) &&
+                        (hlsSegmentFrames >= hlsSegmentSize) &&
                         (avfw->NextFrameIsKeyFrame()))
                     {
+                        hls->SetCurrentSegmentLength(
+                            hlsSegmentFrames / hlsFrameRate);
                         hls->AddSegment();
+                        hlsSegmentSize = (int)(hls->GetCurrentSegmentDuration() *
+                                               hlsFrameRate);
                         avfw->ReOpen(hls->GetCurrentFilename());
 
                         if (avfw2)
@@ -1526,20 +1578,34 @@ int Transcode::TranscodeFile(const QString &inputname,
                 if (elapsed)
                     flagFPS = curFrameNum / elapsed;
 
+                float encodeFPS = 0.0;
+                if (encodeNsecs)
+                    encodeFPS = curFrameNum * 1000000000.0 / encodeNsecs;
+
                 total_frame_count = GetPlayer()->GetCurrentFrameCount();
                 int percentage = curFrameNum * 100 / total_frame_count;
 
                 if (hls)
                     hls->UpdatePercentComplete(percentage);
 
+                // The slower of the two stages limits the overall rate,
+                // a mostly empty decode queue means the decoder is it.
+                QString stages = QString("decode %1 fps, encode %2 fps, "
+                                         "queue %3/%4")
+                    .arg(videoBuffer->GetDecodeFPS(), 0, 'f', 1)
+                    .arg(encodeFPS, 0, 'f', 1)
+                    .arg(videoBuffer->GetAverageOccupancy(), 0, 'f', 1)
+                    .arg(videoBuffer->GetMaxFrames());
+
                 if (jobID >= 0)
                     JobQueue::ChangeJobComment(jobID,
-                              QObject::tr("%1% Completed @ %2 fps.")
-                                          .arg(percentage).arg(flagFPS));
+                              QObject::tr("%1% Completed @ %2 fps (%3).")
+                                          .arg(percentage).arg(flagFPS)
+                                          .arg(stages));
                 else
                     LOG(VB_GENERAL, LOG_INFO,
-                        QString("mythtranscode: %1% Completed @ %2 fps.")
-                            .arg(percentage).arg(flagFPS));
+                        QString("mythtranscode: %1% Completed @ %2 fps (%3).")
+                            .arg(percentage).arg(flagFPS).arg(stages));
 
             }
             curtime = MythDate::current().addSecs(20);
@@ -1549,8 +1615,21 @@ int Transcode::TranscodeFile(const QString &inputname,
         frame.frameNumber = 1 + (curFrameNum << 1);
 
         GetPlayer()->DiscardVideoFrame(lastDecode);
+
+        encodeNsecs += encodeTimer.nsecsElapsed();
     }
 
+    LOG(VB_GENERAL, LOG_INFO, LOC +
+        QString("Pipeline: decoded at %1 fps, encoded at %2 fps, "
+                "decode queue averaged %3 of %4 frames, "
+                "waited for the decoder %5 times")
+            .arg(videoBuffer->GetDecodeFPS(), 0, 'f', 1)
+            .arg(encodeNsecs ? curFrameNum * 1000000000.0 / encodeNsecs : 0.0,
+                 0, 'f', 1)
+            .arg(videoBuffer->GetAverageOccupancy(), 0, 'f', 1)
+            .arg(videoBuffer->GetMaxFrames())
+            .arg(videoBuffer->GetStarvedCount()));
+
     sws_freeContext(scontext);
 
     if (!fifow)
@@ -1590,6 +1669,9 @@ int Transcode::TranscodeFile(const QString &inputname,
 
     if (hls)
     {
+        if (hlsFrameRate > 0.0f)
+            hls->SetCurrentSegmentLength(hlsSegmentFrames / hlsFrameRate);
+
         if (!stopSignalled)
         {
             hls->UpdateStatus(kHLSStatusCompleted);
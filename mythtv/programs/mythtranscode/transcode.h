@@ -37,6 +37,8 @@ class Transcode : public QObject
     void SetCMDBitrate(int bitrate) { cmdBitrate = bitrate; }
     void SetCMDAudioBitrate(int bitrate) { cmdAudioBitrate = bitrate; }
     void DisableAudioOnlyHLS(void) { hlsDisableAudioOnly = true; }
+    void SetEncodingThreads(int threads) { encodingThreads = threads; }
+    void SetDecodeBufferSize(int frames) { decodeBufferSize = frames; }
 
   private:
     bool GetProfile(QString profileName, QString encodingType, int height,
@@ -69,6 +71,8 @@ class Transcode : public QObject
     int                     cmdHeight;
     int                     cmdBitrate;
     int                     cmdAudioBitrate;
+    int                     encodingThreads;
+    int                     decodeBufferSize;
 };
 
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -2,13 +2,17 @@
 
 #include "mythplayer.h"
 #include "videooutbase.h"
+#include "mythtimer.h"
 
 VideoDecodeBuffer::VideoDecodeBuffer(MythPlayer *player, VideoOutput *videoout,
                                      bool cutlist, int size)
   : m_player(player),         m_videoOutput(videoout),
     m_honorCutlist(cutlist),  m_maxFrames(size),
     m_runThread(true),        m_isRunning(false),
-    m_eof(false)
+    m_eof(false),
+    m_framesDecoded(0),       m_decodeNsecs(0),
+    m_occupancySum(0),        m_framesTaken(0),
+    m_starvedCount(0)
 {
 
 }
@@ -34,6 +38,7 @@ void VideoDecodeBuffer::stop(void)
 void VideoDecodeBuffer::run()
 {
     frm_dir_map_t::iterator dm_iter;
+    MythTimer decodeTimer;
 
     m_isRunning = true;
     while (m_runThread)
@@ -49,13 +54,19 @@ void VideoDecodeBuffer::run()
             tfInfo.didFF = 0;
             tfInfo.isKey = false;
 
-            if (m_player->TranscodeGetNextFrame(dm_iter, tfInfo.didFF,
-                tfInfo.isKey, m_honorCutlist))
+            decodeTimer.start();
+            bool gotFrame = m_player->TranscodeGetNextFrame(
+                dm_iter, tfInfo.didFF, tfInfo.isKey, m_honorCutlist);
+            int64_t decodeNsecs = decodeTimer.nsecsElapsed();
+
+            if (gotFrame)
             {
                 tfInfo.frame = m_videoOutput->GetLastDecodedFrame();
 
                 locker.relock();
                 m_frameList.append(tfInfo);
+                m_framesDecoded++;
+                m_decodeNsecs += decodeNsecs;
             }
             else if (m_player->GetEof() != kEofStateNone)
             {
@@ -84,12 +95,15 @@ VideoFrame *VideoDecodeBuffer::GetFrame(int &didFF, bool &isKey)
         if (m_eof)
             return NULL;
 
+        m_starvedCount++;
         m_frameWaitCond.wait(locker.mutex());
 
         if (m_frameList.isEmpty())
             return NULL;
     }
 
+    m_occupancySum += m_frameList.size();
+    m_framesTaken++;
     DecodedFrameInfo tfInfo = m_frameList.takeFirst();
     locker.unlock();
     m_frameWaitCond.wakeAll();
@@ -100,5 +114,27 @@ VideoFrame *VideoDecodeBuffer::GetFrame(int &didFF, bool &isKey)
     return tfInfo.frame;
 }
 
+float VideoDecodeBuffer::GetDecodeFPS(void) const
+{
+    QMutexLocker locker(&m_queueLock);
+    if (!m_decodeNsecs)
+        return 0.0f;
+    return m_framesDecoded * 1000000000.0 / m_decodeNsecs;
+}
+
+float VideoDecodeBuffer::GetAverageOccupancy(void) const
+{
+    QMutexLocker locker(&m_queueLock);
+    if (!m_framesTaken)
+        return 0.0f;
+    return (float)m_occupancySum / m_framesTaken;
+}
+
+uint VideoDecodeBuffer::GetStarvedCount(void) const
+{
+    QMutexLocker locker(&m_queueLock);
+    return m_starvedCount;
+}
+
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
 
@@ -22,6 +22,14 @@ class VideoDecodeBuffer : public QRunnable
     virtual void run();
     VideoFrame *GetFrame(int &didFF, bool &isKey);
 
+    /// Frames decoded per second of decoder thread busy time
+    float GetDecodeFPS(void) const;
+    /// Average number of frames queued when a frame is taken
+    float GetAverageOccupancy(void) const;
+    int   GetMaxFrames(void) const { return m_maxFrames; }
+    /// Number of times GetFrame() had to wait for the decoder
+    uint  GetStarvedCount(void) const;
+
   private:
     typedef struct decodedFrameInfo
     {
@@ -40,6 +48,11 @@ class VideoDecodeBuffer : public QRunnable
     bool                    m_eof;
     QList<DecodedFrameInfo> m_frameList;
     QWaitCondition          m_frameWaitCond;
+    uint64_t                m_framesDecoded;
+    uint64_t                m_decodeNsecs;
+    uint64_t                m_occupancySum;
+    uint64_t                m_framesTaken;
+    uint                    m_starvedCount;
 };
 
 #endif
@@ -507,12 +507,54 @@ static HostSpinBox *JobQueueCheckFrequency()
 {
     HostSpinBox *gc = new HostSpinBox("JobQueueCheckFrequency", 5, 300, 5);
     gc->setLabel(QObject::tr("Job Queue check frequency (secs)"));
-    gc->setHelpText(QObject::tr("When looking for new jobs to process, the "
-                    "Job Queue will wait this many seconds between checks."));
+    gc->setHelpText(QObject::tr("The Job Queue is notified when jobs are "
+                    "added or finish. In addition, it will check for new "
+                    "jobs to process this many seconds apart."));
     gc->setValue(60);
     return gc;
 };
 
+static HostSpinBox *JobQueueMaxTranscodeJobs()
+{
+    HostSpinBox *gc = new HostSpinBox("JobQueueMaxTranscodeJobs", 0, 10, 1);
+    gc->setLabel(QObject::tr("Maximum simultaneous transcode jobs"));
+    gc->setHelpText(QObject::tr("Transcoding is CPU intensive. Limit the "
+                    "number of transcode jobs running at once on this "
+                    "backend so other jobs can still start. Set to 0 to "
+                    "only use the overall maximum."));
+    gc->setValue(0);
+    return gc;
+};
+
+static HostSpinBox *JobQueueMaxCommFlagJobs()
+{
+    HostSpinBox *gc = new HostSpinBox("JobQueueMaxCommFlagJobs", 0, 10, 1);
+    gc->setLabel(QObject::tr("Maximum simultaneous commercial flagging jobs"));
+    gc->setHelpText(QObject::tr("Limit the number of commercial flagging "
+                    "jobs running at once on this backend. Set to 0 to "
+                    "only use the overall maximum."));
+    gc->setValue(0);
+    return gc;
+};
+
+static HostComboBox *JobQueueMaxLoadAverage()
+{
+    // Editable, so any fractional threshold can be entered
+    HostComboBox *gc = new HostComboBox("JobQueueMaxLoadAverage", true);
+    gc->setLabel(QObject::tr("Maximum load average for new jobs"));
+    gc->addSelection(QObject::tr("Unlimited"), "0");
+    for (uint i = 1; i <= 32; i++)
+        gc->addSelection(QString::number(i * 0.5));
+    gc->addSelection("24");
+    gc->addSelection("32");
+    gc->addSelection("64");
+    gc->setHelpText(QObject::tr("While the one minute load average of this "
+                    "backend is above this value, no additional jobs will "
+                    "be started. Fractional values such as 1.5 may be "
+                    "entered. Set to 0 to disable this check."));
+    return gc;
+};
+
 static HostComboBox *JobQueueCPU()
 {
     HostComboBox *gc = new HostComboBox("JobQueueCPU");
@@ -913,6 +955,9 @@ BackendSettings::BackendSettings() {
     VerticalConfigurationGroup* group5 = new VerticalConfigurationGroup(false);
     group5->setLabel(QObject::tr("Job Queue (Backend-Specific)"));
     group5->addChild(JobQueueMaxSimultaneousJobs());
+    group5->addChild(JobQueueMaxTranscodeJobs());
+    group5->addChild(JobQueueMaxCommFlagJobs());
+    group5->addChild(JobQueueMaxLoadAverage());
     group5->addChild(JobQueueCheckFrequency());
 
     HorizontalConfigurationGroup* group5a =